@@ -47,7 +47,7 @@
 #define configUSE_PREEMPTION             1
 #define configUSE_IDLE_HOOK              0
 #define configUSE_TICKLESS_IDLE          0
-#define configUSE_TICK_HOOK              0
+#define configUSE_TICK_HOOK              1
 #define configCPU_CLOCK_HZ               (SystemCoreClock)
 #define configTICK_RATE_HZ               ((TickType_t)1000) // 1000 ticks per second => 1ms tick rate
 #define configMAX_PRIORITIES             (7)
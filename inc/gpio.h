@@ -53,12 +53,15 @@ extern "C" {
 /* === Public function declarations ============================================================ */
 
 /**
- * @brief Registers in the protocol executor the methods of managing digital inputs and outputs
+ * @brief Configures the digital inputs and outputs managed by the protocol methods
  *
- * @return  true    Methods could be successfully registered
- * @return  false   Methods failed to register successfully
+ * @remark The methods are declared at compile time in the protocol descriptors table, so this
+ * function only prepares the hardware used by them.
+ *
+ * @return  true    Digital inputs and outputs could be successfully configured
+ * @return  false   Digital inputs and outputs failed to configure successfully
  */
-bool RegisterGpioMethods(void);
+bool GpioMethodsSetup(void);
 
 /* === End of documentation ==================================================================== */
 
@@ -52,25 +52,66 @@ extern "C" {
  */
 #define ASSERT_EVENT_INVALID_ID 0
 
-/* === Public data type declarations =========================================================== */
+/**
+ * @brief Number of assertions that can be defined at the same time
+ *
+ * Each assertion uses ASSERT_MAX_CONDITIONS flags of the events waited with AssertWaitEvents, so
+ * the flags of all the assertions must fit in the events supported by the user implementation.
+ */
+#ifndef PREAT_ASSERTIONS
+#define PREAT_ASSERTIONS 3
+#endif
 
 /**
- * @brief Pointer to private structure with input handler state
+ * @brief Maximum number of conditions on inputs of each assertion
  */
-typedef struct input_state_s * input_state_t;
+#define ASSERT_MAX_CONDITIONS 8
 
 /**
- * @brief Function to stop an input from sending more events to the assertion
+ * @brief Maximum length, in microseconds, of the time window of an assertion
  *
- * @param  state    Pointer to private structure with input handler state
+ * The times are measured with PreatTimestamp, which wraps around, so the window must be shorter
+ * than half the period of the counter.
+ */
+#define ASSERT_MAX_WINDOW INT32_MAX
+
+/**
+ * @brief Method of the notification frames with the result of an assertion run in background
+ */
+#define ASSERT_NOTIFY_METHOD 0x051
+
+/* === Public data type declarations =========================================================== */
+
+/**
+ * @brief Operators to combine the conditions of an assertion
  */
-typedef void (*input_cleanup_t)(input_state_t state);
+typedef enum assert_operator_e {
+    ASSERT_OPERATOR_AND = 0x00,      /**< All the conditions must occur */
+    ASSERT_OPERATOR_OR = 0x01,       /**< Any of the conditions must occur */
+    ASSERT_OPERATOR_SEQUENCE = 0x02, /**< All the conditions must occur in the registration order */
+    ASSERT_OPERATOR_AT_LEAST = 0x10, /**< At least k conditions, with k in the lower nibble */
+    ASSERT_OPERATOR_BACKGROUND = 0x40,   /**< Flag to evaluate the assertion in background */
+    ASSERT_OPERATOR_MICROSECONDS = 0x80, /**< Flag to give the time window in microseconds */
+} assert_operator_t;
+
+/**
+ * @brief Pointer to private structure with input handler state
+ */
+typedef struct input_state_s * input_state_t;
 
 /**
  * @brief Data type to store the event id associated with an input
  */
 typedef uint32_t event_id_t;
 
+/**
+ * @brief Function to stop an input from sending more events to the assertion
+ *
+ * @param  state    Pointer to private structure with input handler state
+ * @param  id       Event id obtained by the input when it was registered on the assertion
+ */
+typedef void (*input_cleanup_t)(input_state_t state, event_id_t id);
+
 /**
  * @brief Data type to indicate the events that occurred during a wait
  */
@@ -81,62 +122,159 @@ typedef event_id_t event_flags_t;
 /* === Public function declarations ============================================================ */
 
 /**
- * @brief Function to clear an uncompleted assert by an error on the process
+ * @brief Function to clear all the uncompleted asserts by an error on the process
+ *
+ * The pool of assertions is shared by all the server instances and each assertion belongs to the
+ * context that started it. The inputs already registered on the assertions are stopped.
  */
 void AssertClean(void);
 
 /**
  * @brief Function to initiate an assertion about the behavior of inputs
  *
- * @param  parameters       Pointer to array with method parameters
- * @param  count            Count of parameters defined in the array
+ * A context can define several assertions before calling an output method, each one with its own
+ * time window, inputs and operator to combine them. The method responds with the handle that
+ * identifies the new assertion.
+ *
+ * @param  parameters       Pointer to view with the method parameters
+ * @param  count            Count of parameters received in the frame
  * @return preat_error_t    Error code with the result of the new assertion definition
  */
-preat_error_t AssertStart(const preat_parameter_t parameters, uint8_t count);
+preat_error_t AssertStart(preat_parameters_t parameters, uint8_t count);
 
 /**
  * @brief Function to register an input method to send an event to an asertion
  *
+ * The input is registered on the last assertion started by the context.
+ *
+ * @param  context      Object of the caller that executes the input method, from PreatContext
  * @param  cleanup      Function to call to stop an input from sending more events to the assertion
  * @param  state        Pointer to private structure with input handler state
  * @return event_id_t   Event id that should use to report that the expected condition has occurred
  */
-event_id_t AssertRegisterEvent(input_cleanup_t cleanup, input_state_t state);
+event_id_t AssertRegisterEvent(void * context, input_cleanup_t cleanup, input_state_t state);
 
 /**
  * @brief Function to call an exit method and start the assertion timeout
  *
+ * All the assertions defined by the context start at the same time and each one is evaluated on
+ * its own time window. The operator of an assertion is evaluated on each event, so the assertion
+ * ends as soon as its result is known. The method ends when all of them are verified or when the
+ * first one fails, in that case the handle of the failed assertion is returned as the failed
+ * position. The assertions defined with ASSERT_OPERATOR_BACKGROUND are started but not waited,
+ * their results are reported later by AssertNotification.
+ *
  * @param  handler          Function that implements the output method that starts the assertion
- * @param  parameters       Pointer to array with output method parameters
- * @param  count            Count of parameters defined in the array
+ * @param  parameters       Pointer to view with the output method parameters
+ * @param  count            Count of parameters received in the frame
  * @return preat_error_t    Error code with the result of assertion execution
  */
-preat_error_t AssertExecute(preat_method_t handler, preat_parameter_t parameters, uint8_t count);
+preat_error_t AssertExecute(preat_method_t handler, preat_parameters_t parameters, uint8_t count);
+
+/**
+ * @brief Function to query the times of the conditions of the last execution of an assertion
+ *
+ * The method responds with the number of conditions, a byte of flags with the conditions that
+ * occurred, in registration order, and a binary value with the microseconds from the output method
+ * to each condition, as a big endian uint32. The times of the conditions that did not occur are
+ * zero. The conditions out of the time window are also reported.
+ *
+ * @param  parameters       Pointer to view with the method parameters
+ * @param  count            Count of parameters received in the frame
+ * @return preat_error_t    Error code with the result of the query
+ */
+preat_error_t AssertResult(preat_parameters_t parameters, uint8_t count);
+
+/**
+ * @brief Function to abort an assertion not yet executed or running in background
+ *
+ * The cleanup functions of the inputs registered on the assertion are called and the assertion
+ * is released without a notification. Only the context that started the assertion can abort it.
+ *
+ * @param  parameters       Pointer to view with the method parameters
+ * @param  count            Count of parameters received in the frame
+ * @return preat_error_t    Error code with the result of the abort
+ */
+preat_error_t AssertAbort(preat_parameters_t parameters, uint8_t count);
+
+/**
+ * @brief Function to encode a notification frame with the result of an assertion in background
+ *
+ * The assertions defined with ASSERT_OPERATOR_BACKGROUND do not block the output method, they are
+ * evaluated by this function. The server task calls it until it returns false and sends each
+ * frame built with ServerTransmitFrame. Each frame reports the handle and the result of an
+ * assertion, which is released, so its times can be queried with AssertResult.
+ *
+ * @param   context Object of the caller that serves the link, the same that executed the output
+ * @param   frame   Pointer to the buffer to store the frame, at least PREAT_FRAME_MAX_LENGTH
+ * @return  true    A notification frame was stored in the buffer
+ * @return  false   There are no assertions of the context finished
+ */
+bool AssertNotification(void * context, uint8_t * frame);
+
+/**
+ * @brief Function to get the time until the next assertion in background of a context can finish
+ *
+ * The server task uses it to limit the time it sleeps, so a timeout is reported when the window
+ * of the assertion ends. The events that finish an assertion before wake the task on their own.
+ *
+ * @param   context Object of the caller that serves the link, the same that executed the output
+ * @return  uint32_t Milliseconds until the end of the nearest window, UINT32_MAX when there is none
+ */
+uint32_t AssertPendingTime(void * context);
+
+/**
+ * @brief Function to signal from an input handler that the expected conditions have occurred
+ *
+ * The events are stamped with PreatTimestamp before they are set with AssertSetEvent, so the
+ * assertions are evaluated with the resolution of the timestamps instead of the system tick.
+ *
+ * @remark It is called from the interrupt handlers of the inputs.
+ *
+ * @param  events   Flags with the event ids of the conditions that have occurred
+ */
+void AssertSignalEvents(event_flags_t events);
 
 /**
  * @brief Function to inform if an assert was started but not yet executed
  *
- * @return  true    An assert was started but not yet executed
- * @return  false   There is no assertion pending execution
+ * @param   context Object of the caller that executes the method, from PreatContext
+ * @return  true    An assert was started by the context but not yet executed
+ * @return  false   There is no assertion of the context pending execution
  */
-bool AssertIsDefined(void);
+bool AssertIsDefined(void * context);
 
 /**
  * @brief Function provided by user to set an event from input to assert thread
  *
+ * @remark It is called by AssertSignalEvents, the inputs must not call it directly.
+ *
  * @param  id   Identifier obtained by registering the input as an event
  */
 extern void AssertSetEvent(event_id_t id);
 
+/**
+ * @brief Function provided by user to wake the task that serves a context with assertions running
+ * in background
+ *
+ * @remark It is called from the interrupt handlers of the inputs, by AssertSignalEvents.
+ *
+ * @param  context  Object of the caller that executed the output method of the assertion
+ */
+extern void AssertWakeContext(void * context);
+
 /**
  * @brief Function provided by user to pause assert thread while waiting for events
  *
+ * The wait ends when any of the events has occurred. The events returned are cleared, so an event
+ * set between two calls is returned by the second one. With a zero timeout the function returns
+ * the events already occurred without waiting.
+ *
  * @param  events           Flags with the events that wait to be occurred during the assert
  * @param  timeout          Time, in milliseconds, to wait for the arrival of events
- * @param  wait_for_all     Flag to indicate if any or all events are expected
  * @return event_flags_t    Flags with the events that occurred during the wait
  */
-extern event_flags_t AssertWaitEvents(event_flags_t events, uint32_t timeout, bool wait_for_all);
+extern event_flags_t AssertWaitEvents(event_flags_t events, uint32_t timeout);
 
 /* === End of documentation ==================================================================== */
 
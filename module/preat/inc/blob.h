@@ -0,0 +1,143 @@
+/************************************************************************************************
+Copyright (c) 2022-2023, Laboratorio de Microprocesadores
+Facultad de Ciencias Exactas y Tecnología, Universidad Nacional de Tucumán
+https://www.microprocesadores.unt.edu.ar/
+
+Copyright (c) 2022-2023, Esteban Volentini <evolentini@herrera.unt.edu.ar>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+#ifndef BLOB_H
+#define BLOB_H
+
+/** @file
+ ** @brief Binary large objects storage declarations
+ **
+ ** @addtogroup preat PREAT
+ ** @brief Protocol for Remote Excecution of Automated Tests
+ ** @{ */
+
+/* === Headers files inclusions ================================================================ */
+
+#include "protocol.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+/**
+ * @brief Size in bytes of each block of the pool used to store the blobs
+ *
+ * Each blob is stored in a single contiguous block, so this is the maximum size of a blob. The
+ * limit is reported to the host as the last value of the BLOB.Available response.
+ */
+#ifndef BLOB_BLOCK_SIZE
+#define BLOB_BLOCK_SIZE 1024
+#endif
+
+/**
+ * @brief Number of blocks in the pool, and therefore the maximum number of blobs defined at once
+ */
+#ifndef BLOB_BLOCKS_COUNT
+#define BLOB_BLOCKS_COUNT 8
+#endif
+
+/* === Public data type declarations =========================================================== */
+
+/* === Public variable declarations ============================================================ */
+
+/* === Public function declarations ============================================================ */
+
+/**
+ * @brief Function to destroy all the blobs and return their blocks to the pool
+ *
+ * The pool is shared by all the server instances, this function and the blob methods access it
+ * holding PREAT_LOCK_BLOBS.
+ */
+void BlobClean(void);
+
+/**
+ * @brief Function to get the content of a blob previously defined
+ *
+ * @remark The content is not copied, the returned pointer references the blob storage and it is
+ * valid until the blob is destroyed. Uses that outlive the method call must take it with BlobPin.
+ *
+ * @param   id          Identifier of the blob
+ * @param   size        Pointer to a variable to store the size in bytes of the blob
+ * @return  uint8_t*    Pointer to the first byte of the blob, NULL if the blob is not defined
+ */
+const uint8_t * BlobData(uint8_t id, uint32_t * size);
+
+/**
+ * @brief Function to get the storage of a blob to load its content without intermediate copies
+ *
+ * @param   id          Identifier of the blob
+ * @param   size        Pointer to a variable to store the size in bytes of the blob
+ * @return  uint8_t*    Pointer to the first byte of the blob, NULL if the blob is not defined
+ */
+uint8_t * BlobStorage(uint8_t id, uint32_t * size);
+
+/**
+ * @brief Function to get the storage of a blob and keep it in use until it is unpinned
+ *
+ * While a blob is pinned BLOB.Update and BLOB.Destroy fail with PREAT_BUSY_ERROR, so the returned
+ * pointer stays valid from other server instances during a bulk transfer or a program execution.
+ *
+ * @param   id          Identifier of the blob
+ * @param   size        Pointer to a variable to store the size in bytes of the blob
+ * @return  uint8_t*    Pointer to the first byte of the blob, NULL if the blob is not defined
+ */
+uint8_t * BlobPin(uint8_t id, uint32_t * size);
+
+/**
+ * @brief Function to release a blob pinned with BlobPin
+ *
+ * @remark This function does not take PREAT_LOCK_BLOBS, so it can be called from the interrupt
+ * that ends a bulk transfer.
+ *
+ * @param   id          Identifier of the blob
+ */
+void BlobUnpin(uint8_t id);
+
+/**
+ * @brief Function to get the content of a blob referenced by a parameter of a method call
+ *
+ * @param   parameters  Pointer to view with the parameters received by the method
+ * @param   index       Position of the parameter in the method call
+ * @param   size        Pointer to a variable to store the size in bytes of the blob
+ * @return  uint8_t*    Pointer to the first byte of the blob, NULL if the parameter is not a blob
+ *                      reference or the blob is not defined
+ */
+const uint8_t * BlobParameter(preat_parameters_t parameters, uint8_t index, uint32_t * size);
+
+/* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} End of module definition for doxygen */
+
+#endif /* BLOB_H */
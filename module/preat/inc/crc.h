@@ -55,6 +55,35 @@ extern "C" {
  */
 #define CRC_ALGO_TABLE_DRIVEN 1
 
+/**
+ * Kernel that processes one nibble per step with a table of 16 entries, for flash constrained
+ * boards.
+ */
+#define CRC_KERNEL_NIBBLE 0
+
+/**
+ * Kernel that processes one byte per step with a table of 256 entries, the generated one.
+ */
+#define CRC_KERNEL_TABLE 1
+
+/**
+ * Kernel that processes four bytes per step with four tables of 256 entries.
+ */
+#define CRC_KERNEL_SLICE4 2
+
+/**
+ * Kernel that processes eight bytes per step with eight tables of 256 entries.
+ */
+#define CRC_KERNEL_SLICE8 3
+
+/**
+ * The kernel used by crc_update(), selected at build time. Defining CRC_ALL_KERNELS also builds
+ * and exports every kernel, to compare them in tests and benchmarks.
+ */
+#ifndef CRC_KERNEL
+#define CRC_KERNEL CRC_KERNEL_TABLE
+#endif
+
 /**
  * The type of the CRC values.
  *
@@ -81,6 +110,17 @@ static inline crc_t crc_init(void) {
  */
 crc_t crc_update(crc_t crc, const void * data, size_t data_len);
 
+#if defined(CRC_ALL_KERNELS)
+/**
+ * Update the crc value with new data using a specific kernel, with the same parameters and
+ * result as crc_update().
+ */
+crc_t crc_update_nibble(crc_t crc, const void * data, size_t data_len);
+crc_t crc_update_table(crc_t crc, const void * data, size_t data_len);
+crc_t crc_update_slice4(crc_t crc, const void * data, size_t data_len);
+crc_t crc_update_slice8(crc_t crc, const void * data, size_t data_len);
+#endif
+
 /**
  * Calculate the final crc value.
  *
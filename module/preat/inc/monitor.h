@@ -0,0 +1,153 @@
+/************************************************************************************************
+Copyright (c) 2022-2023, Laboratorio de Microprocesadores
+Facultad de Ciencias Exactas y Tecnología, Universidad Nacional de Tucumán
+https://www.microprocesadores.unt.edu.ar/
+
+Copyright (c) 2022-2023, Esteban Volentini <evolentini@herrera.unt.edu.ar>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+#ifndef MONITOR_H
+#define MONITOR_H
+
+/** @file
+ ** @brief Monitor of inputs events declarations
+ **
+ ** The monitor records the edges of the selected inputs with a timestamp and sends them to the
+ ** host in notification frames, several events in each frame, without a request of the host.
+ **
+ ** @addtogroup preat PREAT
+ ** @brief Protocol for Remote Excecution of Automated Tests
+ ** @{ */
+
+/* === Headers files inclusions ================================================================ */
+
+#include "protocol.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+/**
+ * @brief Number of events recorded waiting to be notified, it must be a power of two
+ */
+#ifndef PREAT_MONITOR_EVENTS
+#define PREAT_MONITOR_EVENTS 64
+#endif
+
+/**
+ * @brief Method of the notification frames with the recorded events
+ */
+#define MONITOR_NOTIFY_METHOD 0x050
+
+/**
+ * @brief Size in bytes of each event in a notification frame
+ */
+#define MONITOR_EVENT_SIZE 4
+
+/**
+ * @brief Maximum number of events sent in each notification frame
+ */
+#define MONITOR_FRAME_EVENTS ((PREAT_RESULTS_SIZE - 7) / MONITOR_EVENT_SIZE)
+
+/**
+ * @brief Flag in the first byte of an event in a notification frame for a rissing edge
+ */
+#define MONITOR_RISSING_EDGE 0x80
+
+/**
+ * @brief Maximum time, in microseconds, between the first and the last event of a notification
+ */
+#define MONITOR_MAX_OFFSET 0xFFFFFF
+
+/* === Public data type declarations =========================================================== */
+
+/* === Public variable declarations ============================================================ */
+
+/* === Public function declarations ============================================================ */
+
+/**
+ * @brief Function to start the monitor for a context, or to keep it if the context already has it
+ *
+ * The monitor is shared by all the server instances and it belongs to the context that started it
+ * until it is stopped. The events recorded before the start are discarded.
+ *
+ * @param   context Object of the caller that executes the method, from PreatContext
+ * @return  true    The monitor belongs to the context
+ * @return  false   The monitor belongs to other context
+ */
+bool MonitorStart(void * context);
+
+/**
+ * @brief Function to stop the monitor and discard the events not yet notified
+ *
+ * @param   context Object of the caller that executes the method, from PreatContext
+ * @return  true    The monitor is stopped
+ * @return  false   The monitor belongs to other context and it is kept running
+ */
+bool MonitorStop(void * context);
+
+/**
+ * @brief Function to record an edge of an input, called from the interrupt handler of the input
+ *
+ * The event is stamped with PreatTimestamp. When there is no free space the event is discarded and
+ * counted as lost in the next notification.
+ *
+ * @param   source  Number of the input where the edge occurred, from 0 to 127
+ * @param   rissing Flag to indicate a rissing edge, otherwise it is a falling edge
+ */
+void MonitorRecord(uint8_t source, bool rissing);
+
+/**
+ * @brief Function to encode a notification frame with the events recorded for a context
+ *
+ * The server task calls this function until it returns false and sends each frame built with
+ * ServerTransmitFrame, so the events recorded at a high rate are coalesced in a few frames.
+ *
+ * @param   context Object of the caller that serves the link, the same used to start the monitor
+ * @param   frame   Pointer to the buffer to store the frame, at least PREAT_FRAME_MAX_LENGTH
+ * @return  true    A notification frame was stored in the buffer
+ * @return  false   There are no events to notify to the context
+ */
+bool MonitorNotification(void * context, uint8_t * frame);
+
+/**
+ * @brief Function provided by user to wake the task that serves a context when there are events
+ *
+ * @remark It is called from the interrupt handler that records the first event pending of notify.
+ *
+ * @param   context Object of the caller that started the monitor
+ */
+extern void MonitorSetEvent(void * context);
+
+/* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} End of module definition for doxygen */
+
+#endif /* MONITOR_H */
@@ -37,6 +37,9 @@ SPDX-License-Identifier: MIT
 
 #include "protocol.h"
 #include "assertion.h"
+#include "blob.h"
+#include "monitor.h"
+#include "program.h"
 
 /* === Cabecera C++ ============================================================================ */
 
@@ -0,0 +1,91 @@
+/************************************************************************************************
+Copyright (c) 2022-2023, Laboratorio de Microprocesadores
+Facultad de Ciencias Exactas y Tecnología, Universidad Nacional de Tucumán
+https://www.microprocesadores.unt.edu.ar/
+
+Copyright (c) 2022-2023, Esteban Volentini <evolentini@herrera.unt.edu.ar>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+#ifndef PROGRAM_H
+#define PROGRAM_H
+
+/** @file
+ ** @brief Stored test programs engine declarations
+ **
+ ** @addtogroup preat PREAT
+ ** @brief Protocol for Remote Excecution of Automated Tests
+ ** @{ */
+
+/* === Headers files inclusions ================================================================ */
+
+#include "protocol.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+/**
+ * @brief Maximum number of steps in a stored program
+ */
+#ifndef PROGRAM_MAX_STEPS
+#define PROGRAM_MAX_STEPS 64
+#endif
+
+/**
+ * @brief Maximum number of steps executed in a single run
+ *
+ * A run that reaches this count ends with a timeout error, so a branch back without an exit can
+ * not keep the program lock forever.
+ */
+#ifndef PROGRAM_MAX_EXECUTED
+#define PROGRAM_MAX_EXECUTED 100000
+#endif
+
+/* === Public data type declarations =========================================================== */
+
+/* === Public variable declarations ============================================================ */
+
+/* === Public function declarations ============================================================ */
+
+/**
+ * @brief Function provided by user to pause the execution of a program
+ *
+ * @remark The pause should not depend on the phase of the system tick, waiting the last fraction
+ * of a tick with a microseconds counter as PreatTimestamp.
+ *
+ * @param  delay    Time, in milliseconds, to pause the program
+ */
+extern void ProgramDelay(uint32_t delay);
+
+/* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} End of module definition for doxygen */
+
+#endif /* PROGRAM_H */
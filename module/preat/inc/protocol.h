@@ -36,6 +36,7 @@ SPDX-License-Identifier: MIT
 /* === Headers files inclusions ================================================================ */
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 /* === Cabecera C++ ============================================================================ */
@@ -46,6 +47,98 @@ extern "C" {
 
 /* === Public macros definitions =============================================================== */
 
+/**
+ * @brief Minimum length of a valid frame, including the length field and the CRC
+ */
+#define PREAT_FRAME_MIN_LENGTH 5
+
+/**
+ * @brief Maximum length of a valid frame, including the length field and the CRC
+ */
+#define PREAT_FRAME_MAX_LENGTH 64
+
+/**
+ * @brief Flag in the length field to indicate a frame with a sequence number
+ *
+ * Sequenced frames carry an extra byte with a sequence number after the length field, and the
+ * response to them carries the same sequence number so a host can pipeline several frames.
+ */
+#define PREAT_SEQUENCED_FRAME 0x80
+
+/**
+ * @brief Value in the length field to indicate a frame with an extended length
+ *
+ * Extended frames carry their total length in the two bytes following the length field, so they
+ * can exceed PREAT_FRAME_MAX_LENGTH. The flag PREAT_SEQUENCED_FRAME can be combined with this value
+ * and then the sequence number follows the extended length.
+ */
+#define PREAT_EXTENDED_FRAME 0x00
+
+/**
+ * @brief Maximum length of a valid extended frame, including the header and the CRC
+ */
+#ifndef PREAT_FRAME_EXTENDED_LENGTH
+#define PREAT_FRAME_EXTENDED_LENGTH 512
+#endif
+
+/**
+ * @brief Maximum number of parameters accepted in a method call
+ */
+#define PREAT_MAX_PARAMETERS 8
+
+/**
+ * @brief Maximum size in bytes of the values returned by a method in the response
+ */
+#define PREAT_RESULTS_SIZE (PREAT_FRAME_MAX_LENGTH - 7)
+
+/**
+ * @brief Number of frames that a host can send ahead without waiting for their responses
+ */
+#ifndef PREAT_PIPELINE_DEPTH
+#define PREAT_PIPELINE_DEPTH 4
+#endif
+
+/**
+ * @brief Name of the section where the descriptors of the statically declared methods are stored
+ */
+#define PREAT_METHODS_SECTION "preat_methods"
+
+/**
+ * @brief Code used in the signature of a method for each parameter data type
+ */
+#define PREAT_TYPE_CODE(type) (((type)&TYPE_BINARY) ? 0x08u : (uint32_t)(type))
+
+/**
+ * @brief Packs the data type of the parameter in a given position in the signature of a method
+ */
+#define PREAT_PARAMETER(index, type) (PREAT_TYPE_CODE(type) << (4 * (index)))
+
+/**
+ * @brief Signature of a method with a single uint8 parameter
+ */
+#define PREAT_SINGLE_UINT8 PREAT_PARAMETER(0, TYPE_UINT8)
+
+/**
+ * @brief Declares a protocol method in the table of descriptors stored in read only memory
+ *
+ * The descriptors are placed by the linker in a contiguous section, so the methods declared with
+ * this macro do not use RAM and do not require any registration at startup.
+ *
+ * @param   name            Name of the constant with the method descriptor
+ * @param   method_id       Unique number to idetify the method in the protocol
+ * @param   is_output       Flag to indicate that the method implements an output action
+ * @param   method_handler  Function to call when protocol method is excecuted
+ * @param   parameters      Signature with the parameters required by the function
+ */
+#define PREAT_METHOD(name, method_id, is_output, method_handler, parameters)                     \
+    static const struct handler_descriptor_s name                                              \
+        __attribute__((section(PREAT_METHODS_SECTION), used)) = {                                \
+            .output = is_output,                                                                 \
+            .id = method_id,                                                                     \
+            .signature = parameters,                                                             \
+            .handler = method_handler,                                                           \
+    }
+
 /**
  * @brief Result of the execution of a method
  */
@@ -58,6 +151,10 @@ typedef enum preat_error_e {
     PREAT_TIMEOUT_ERROR = 0x05,
     PREAT_UNDEFINED_ERROR = 0x06,
     PREAT_REDEFINED_ERROR = 0x07,
+    PREAT_MEMORY_ERROR = 0x08,
+    PREAT_FRAMING_ERROR = 0x09,
+    PREAT_SEQUENCE_ERROR = 0x0A,
+    PREAT_BUSY_ERROR = 0x0B,
     PREAT_GENERIC_ERROR = 0xFF,
 } preat_error_t;
 
@@ -74,24 +171,73 @@ typedef enum preat_type_e {
 } preat_type_t;
 
 /**
- * @brief Parameter definition to execute a method
+ * @brief Shared protocol state that the tasks executing frames must access one at a time
+ */
+typedef enum preat_lock_e {
+    PREAT_LOCK_BLOBS = 0,     /**< Pool of blocks of the blob store */
+    PREAT_LOCK_ASSERTION = 1, /**< Pool of assertions, held while an assertion is changed */
+    PREAT_LOCK_PROGRAM = 2,   /**< Program interpreter, held while a program is running */
+    PREAT_LOCK_METHODS = 3,   /**< Table of methods, held while methods are registered */
+    PREAT_LOCK_TRANSMIT = 4,  /**< Transmit queues of the servers, held while a frame is queued */
+    PREAT_LOCK_MONITOR = 5,   /**< Owner of the events monitor, held while it is changed or read */
+    PREAT_LOCK_COUNT,         /**< Number of locks that must be provided by the user */
+} preat_lock_t;
+
+/**
+ * @brief Values returned by a method, encoded with the same format of the parameters field
+ */
+typedef struct preat_results_s {
+    uint8_t count;                    /**< Number of values stored in the results */
+    uint8_t length;                   /**< Number of bytes used to encode the values */
+    uint8_t types;                    /**< Position of the last byte with data types */
+    uint8_t failed;                   /**< Position plus one of the inner call that failed */
+    uint8_t data[PREAT_RESULTS_SIZE]; /**< Encoded data types and values */
+    void * context;                   /**< Object of the caller that executes the frame */
+} * preat_results_t;
+
+/**
+ * @brief View over the parameters of a received frame to execute a method
+ *
+ * The frame is validated before the method is called but the values are not copied, they are
+ * decoded from the received bytes only when the method reads them with PreatParameterValue.
+ */
+typedef struct preat_parameters_s {
+    const uint8_t * data;                   /**< Pointer to the first byte of the method call */
+    uint32_t signature;                     /**< Data types of the parameters in the frame */
+    uint16_t offsets[PREAT_MAX_PARAMETERS]; /**< Position in the frame of each parameter value */
+    uint8_t lengths[PREAT_MAX_PARAMETERS];  /**< Size in the frame of each parameter value */
+    preat_results_t results;                /**< Values to return in the response of the call */
+} const * preat_parameters_t;
+
+/**
+ * @brief Reference to a byte string parameter stored in the received frame
  */
-typedef struct preat_parameter_s {
-    preat_type_t type;
-    uint32_t value;
-} * preat_parameter_t;
+typedef struct preat_slice_s {
+    const uint8_t * data; /**< Pointer to the first byte of the value, NULL if it is not valid */
+    uint8_t length;       /**< Number of bytes of the value */
+} preat_slice_t;
 
 /**
  * @brief Callback function to implement an method to set a condition by an output action
  *
- * @param  parameters       Pointer to list of parameters to excecute the method
- * @param  count            Count of parameters sended in the list of parameters
+ * @param  parameters       Pointer to view with the parameters to excecute the method
+ * @param  count            Count of parameters sended in the frame
  * @return preat_error_t    Result of the execution of the method
  */
-typedef preat_error_t (*preat_method_t)(const preat_parameter_t parameters, uint8_t count);
+typedef preat_error_t (*preat_method_t)(preat_parameters_t parameters, uint8_t count);
 
 /* === Public data type declarations =========================================================== */
 
+/**
+ * @brief Descriptor of a method implemented in the protocol
+ */
+typedef struct handler_descriptor_s {
+    bool output : 1;        /**< Flag to indicate that the method implements an output action */
+    uint16_t id : 15;       /**< Unique number to idetify the method in the protocol */
+    uint32_t signature;     /**< Data types of the parameters packed with PREAT_PARAMETER */
+    preat_method_t handler; /**< Function to call when protocol method is excecuted */
+} const * handler_descriptor_t;
+
 /* === Public variable declarations ============================================================ */
 
 /**
@@ -102,25 +248,282 @@ extern const preat_type_t SINGLE_UINT8_PARAM[];
 /* === Public function declarations ============================================================ */
 
 /**
- * @brief Register a function to implemente an protocol method to drive outputs actions
+ * @brief Function provided by user to take a lock that serializes the access to shared state
+ *
+ * The lock must be recursive, a task that already holds it can take it again and it must release
+ * it the same number of times. It is called only from the tasks that execute frames.
+ *
+ * @param   lock        Shared state to access
+ */
+extern void PreatLock(preat_lock_t lock);
+
+/**
+ * @brief Function provided by user to release a lock taken with PreatLock
+ *
+ * @param   lock        Shared state accessed
+ */
+extern void PreatUnlock(preat_lock_t lock);
+
+/**
+ * @brief Function provided by user to read a free running counter of microseconds
+ *
+ * The counter is used to stamp events with a resolution better than the system tick, it can wrap
+ * around and it must be callable from interrupt handlers.
+ *
+ * @return  uint32_t    Current value of the counter
+ */
+extern uint32_t PreatTimestamp(void);
+
+/**
+ * @brief Get the object of the caller that executes the method currently in execution
+ *
+ * @param   parameters  Pointer to view with the parameters received by the method
+ * @return  void*       Context given to PreatExecuteChecked, NULL if there is none
+ */
+static inline void * PreatContext(preat_parameters_t parameters) {
+    return parameters->results ? parameters->results->context : NULL;
+}
+
+/**
+ * @brief Check if a frame uses an extended length field
+ *
+ * @param   frame       Pointer to the first byte of the frame
+ * @return  true        The length of the frame is in the two bytes following the first one
+ * @return  false       The length of the frame is in the first byte
+ */
+static inline bool PreatFrameIsExtended(const uint8_t * frame) {
+    return (frame[0] & ~PREAT_SEQUENCED_FRAME) == PREAT_EXTENDED_FRAME;
+}
+
+/**
+ * @brief Get the number of bytes used by the header of a frame before the method field
+ *
+ * @param   frame       Pointer to the first byte of the frame
+ * @return  uint8_t     Size of the length fields and the sequence number of the frame
+ */
+static inline uint8_t PreatFrameHeader(const uint8_t * frame) {
+    uint8_t result = PreatFrameIsExtended(frame) ? 3 : 1;
+
+    return (frame[0] & PREAT_SEQUENCED_FRAME) ? result + 1 : result;
+}
+
+/**
+ * @brief Get the total length of a frame from its length field
+ *
+ * @param   frame       Pointer to the first byte of the frame
+ * @return  uint16_t    Total length of the frame in bytes, including the length field and the CRC
+ */
+static inline uint16_t PreatFrameLength(const uint8_t * frame) {
+    uint16_t result = frame[0] & ~PREAT_SEQUENCED_FRAME;
+
+    if (result == PREAT_EXTENDED_FRAME) {
+        result = ((uint16_t)frame[1] << 8) | frame[2];
+    }
+    return result;
+}
+
+/**
+ * @brief Get the number of bytes used in the frame by a parameter value of a data type
+ *
+ * @param   type        Data type of the parameter
+ * @return  uint8_t     Size in bytes of the value, or zero if the data type has not a fixed size
+ */
+static inline uint8_t PreatTypeSize(preat_type_t type) {
+    uint8_t result = 0;
+
+    switch (type) {
+    case TYPE_UINT8:
+    case TYPE_BLOB:
+        result = 1;
+        break;
+    case TYPE_UINT16:
+        result = 2;
+        break;
+    case TYPE_UINT32:
+        result = 4;
+        break;
+    default:
+        break;
+    }
+    return result;
+}
+
+/**
+ * @brief Get the data type of a parameter received in a method call
+ *
+ * @param   parameters      Pointer to view with the parameters received by the method
+ * @param   index           Position of the parameter in the method call
+ * @return  preat_type_t    Data type of the parameter, TYPE_UNDEFINED if it was not received
+ */
+static inline preat_type_t PreatParameterType(preat_parameters_t parameters, uint8_t index) {
+    uint8_t code = 0;
+
+    if (index < PREAT_MAX_PARAMETERS) {
+        code = (parameters->signature >> (4 * index)) & 0x0F;
+    }
+    return (code == PREAT_TYPE_CODE(TYPE_BINARY)) ? TYPE_BINARY : (preat_type_t)code;
+}
+
+/**
+ * @brief Decode the value of an integer parameter received in a method call
+ *
+ * @param   parameters  Pointer to view with the parameters received by the method
+ * @param   index       Position of the parameter in the method call
+ * @return  uint32_t    Value of the parameter, zero if it was not received
+ */
+static inline uint32_t PreatParameterValue(preat_parameters_t parameters, uint8_t index) {
+    uint8_t size = PreatTypeSize(PreatParameterType(parameters, index));
+    uint32_t result = 0;
+
+    for (uint8_t position = 0; position < size; position++) {
+        result = (result << 8) | parameters->data[parameters->offsets[index] + position];
+    }
+    return result;
+}
+
+/**
+ * @brief Get a binary parameter received in a method call as a slice of the received frame
+ *
+ * @remark The value is not copied, the slice references the received frame and it is only valid
+ * during the execution of the method.
+ *
+ * @param   parameters      Pointer to view with the parameters received by the method
+ * @param   index           Position of the parameter in the method call
+ * @return  preat_slice_t   Slice with the bytes of the value, empty if it is not a binary value
+ */
+static inline preat_slice_t PreatParameterSlice(preat_parameters_t parameters, uint8_t index) {
+    preat_slice_t result = {.data = NULL, .length = 0};
+
+    if (PreatParameterType(parameters, index) == TYPE_BINARY) {
+        result.data = &(parameters->data[parameters->offsets[index]]);
+        result.length = parameters->lengths[index];
+    }
+    return result;
+}
+
+/**
+ * @brief Function called for each method declared with PREAT_METHOD that could not be indexed
+ *
+ * A method is not indexed when its identifier is used by other method declared before it, or when
+ * the dispatch table has no free pages. The default implementation fails an assert, stopping the
+ * debug builds, and the application can provide its own to log the conflict.
+ *
+ * @param   id          Identifier of the method that could not be indexed
+ */
+void PreatMethodConflict(uint16_t id);
+
+/**
+ * @brief Function to get the number of methods declared with PREAT_METHOD that were not indexed
+ *
+ * @return  uint8_t     Number of methods that are not reachable because of a conflict
+ */
+uint8_t PreatMethodConflicts(void);
+
+/**
+ * @brief Register at runtime a function to implemente an protocol method
+ *
+ * @remark Methods known at compile time should be declared with PREAT_METHOD instead, this
+ * function is kept for methods that can only be defined at runtime.
  *
  * @param   id          Unique number to idetify the method in the protocol
  * @param   output      Function implement an method for control outputs
  * @param   handler     Function to call when protocol method is excecuted
  * @param   parameters  Definition of the parameters required by the function
  * @return  true        Function could be successfully registered
- * @return  false       Function failed to register successfully
+ * @return  false       Function failed to register successfully or the id is already in use
  */
 bool PreatRegister(uint16_t id, bool output, preat_method_t handler,
                    preat_type_t const * parameters);
 
+/**
+ * @brief Append a value to the response of the method currently in execution
+ *
+ * @param   parameters  Pointer to view with the parameters received by the method
+ * @param   type        Data type of the value to return
+ * @param   value       Value to return in the response
+ * @return  true        Value could be appended to the response
+ * @return  false       There is no more space in the response for the value
+ */
+bool PreatResultAppend(preat_parameters_t parameters, preat_type_t type, uint32_t value);
+
+/**
+ * @brief Append a sequence of bytes to the response of the method currently in execution
+ *
+ * @remark The bytes use a whole data type byte, so they can only follow an even number of values.
+ *
+ * @param   parameters  Pointer to view with the parameters received by the method
+ * @param   data        Pointer to the bytes to return
+ * @param   length      Number of bytes to return, from 1 to 127
+ * @return  true        Bytes could be appended to the response
+ * @return  false       There is no more space in the response or the bytes can not be appended
+ */
+bool PreatResultAppendBytes(preat_parameters_t parameters, const uint8_t * data, uint8_t length);
+
+/**
+ * @brief Report the position of the inner call that made the method currently in execution fail
+ *
+ * Methods that execute other calls, like batches or programs, use this function so the error
+ * response includes the position of the failed call after the error code.
+ *
+ * @param   parameters  Pointer to view with the parameters received by the method
+ * @param   position    Position of the inner call that failed
+ */
+void PreatResultFailed(preat_parameters_t parameters, uint8_t position);
+
+/**
+ * @brief Decode a method call, without executing it, and advance to the next call
+ *
+ * @param   cursor          Pointer to the first byte of the call, updated to the following byte
+ * @param   end             Pointer to the byte after the last one available for the call
+ * @return  preat_error_t   Result of the validation of the call encoding
+ */
+preat_error_t PreatSkipCall(const uint8_t ** cursor, const uint8_t * end);
+
+/**
+ * @brief Decode a method call, execute it through the methods table and advance to the next call
+ *
+ * @param   cursor          Pointer to the first byte of the call, updated to the following byte
+ * @param   end             Pointer to the byte after the last one available for the call
+ * @param   results         Pointer to the structure to store the values returned by the method
+ * @return  preat_error_t   Result of the execution of the method
+ */
+preat_error_t PreatExecuteCall(const uint8_t ** cursor, const uint8_t * end,
+                               preat_results_t results);
+
+/**
+ * @brief Encode a frame sent by the device without a request, like an event notification
+ *
+ * @param   frame       Pointer to the buffer to store the frame, at least PREAT_FRAME_MAX_LENGTH
+ * @param   method      Method of the notification
+ * @param   results     Values to send as the parameters of the notification
+ */
+void PreatEncodeNotification(uint8_t * frame, uint16_t method, preat_results_t results);
+
 /**
  * @brief Decode a protocol frame and executes the corresponding method
  *
- * @param   frame       Received frame with a command to execute a method
+ * @param   frame       Received frame with a command to execute a method, it's replaced with the
+ *                      response frame
  */
 void PreatExecute(uint8_t * frame);
 
+/**
+ * @brief Executes a frame already checked by the transport while it was received
+ *
+ * Transports that compute the CRC as the bytes arrive use this function to avoid a second pass
+ * over the frame. The length of the frame is validated anyway. When the transport reports an error
+ * the frame is not executed and the response reports that error, keeping the sequence number of
+ * the frame if its header was received.
+ *
+ * @param   frame       Received frame with a command to execute a method, it's replaced with the
+ *                      response frame
+ * @param   status      Result of the checks made by the transport, PREAT_NO_ERROR when the CRC of
+ *                      the frame is valid
+ * @param   context     Object of the caller available to the methods with PreatContext, the
+ *                      servers use their own instance
+ */
+void PreatExecuteChecked(uint8_t * frame, preat_error_t status, void * context);
+
 /* === End of documentation ==================================================================== */
 
 #ifdef __cplusplus
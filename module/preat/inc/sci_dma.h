@@ -0,0 +1,120 @@
+/************************************************************************************************
+Copyright (c) 2022-2023, Laboratorio de Microprocesadores
+Facultad de Ciencias Exactas y Tecnología, Universidad Nacional de Tucumán
+https://www.microprocesadores.unt.edu.ar/
+
+Copyright (c) 2022-2023, Esteban Volentini <evolentini@herrera.unt.edu.ar>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+#ifndef SCI_DMA_H
+#define SCI_DMA_H
+
+/** @file
+ ** @brief Serial port DMA operations required by the preat server declarations
+ **
+ ** The board support must implement these functions to use the serial server with DMA transfers,
+ ** enabled when the module is compiled with the PREAT_SERIAL_DMA define.
+ **
+ ** @addtogroup preat PREAT
+ ** @brief Protocol for Remote Excecution of Automated Tests
+ ** @{ */
+
+/* === Headers files inclusions ================================================================ */
+
+#include "hal.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+/* === Public data type declarations =========================================================== */
+
+/**
+ * @brief Events raised by the DMA transfers of a serial port
+ */
+typedef enum sci_dma_event_e {
+    SCI_DMA_RECEIVE_IDLE,     /**< The receive line is idle after receiving some bytes */
+    SCI_DMA_RECEIVE_HALF,     /**< The receive DMA reached the half or the end of the buffer */
+    SCI_DMA_TRANSMIT_DONE,    /**< The last transmit DMA transfer ended */
+} sci_dma_event_t;
+
+/**
+ * @brief Callback function to notify the events of the DMA transfers
+ *
+ * @param   sci     Serial port descriptor that raises the event
+ * @param   event   Event raised by the DMA transfers
+ * @param   object  Pointer to user data declared when the transfers were started
+ */
+typedef void (*sci_dma_handler_t)(hal_sci_t sci, sci_dma_event_t event, void * object);
+
+/* === Public variable declarations ============================================================ */
+
+/* === Public function declarations ============================================================ */
+
+/**
+ * @brief Function to start the circular receive DMA transfer of a serial port
+ *
+ * @param   sci     Serial port descriptor, already configured with SciSetConfig
+ * @param   buffer  Pointer to the circular buffer where the DMA stores the received bytes
+ * @param   size    Size in bytes of the circular buffer
+ * @param   handler Callback function to notify the events of the DMA transfers
+ * @param   object  Pointer to user data to send as parameter in the callback function
+ * @return  true    The transfer was started
+ * @return  false   The serial port does not support DMA transfers
+ */
+bool SciDmaStart(hal_sci_t sci, uint8_t * buffer, uint16_t size, sci_dma_handler_t handler,
+                 void * object);
+
+/**
+ * @brief Function to get the position of the next byte that the receive DMA will write
+ *
+ * @param   sci         Serial port descriptor
+ * @return  uint16_t    Offset of the next byte to write in the circular buffer
+ */
+uint16_t SciDmaReceivePosition(hal_sci_t sci);
+
+/**
+ * @brief Function to start a single transmit DMA transfer
+ *
+ * @remark The data must not be modified until the SCI_DMA_TRANSMIT_DONE event is raised.
+ *
+ * @param   sci     Serial port descriptor
+ * @param   data    Pointer to the data to send
+ * @param   size    Number of bytes to send
+ * @return  true    The transfer was started
+ * @return  false   The transfer could not be started
+ */
+bool SciDmaSend(hal_sci_t sci, const void * data, uint16_t size);
+
+/* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} End of module definition for doxygen */
+
+#endif /* SCI_DMA_H */
@@ -46,6 +46,111 @@ extern "C" {
 
 /* === Public macros definitions =============================================================== */
 
+/**
+ * @brief Number of server instances that can run at once, each one with its own transport
+ */
+#ifndef PREAT_SERVER_INSTANCES
+#define PREAT_SERVER_INSTANCES 2
+#endif
+
+/**
+ * @brief Size in bytes of the transmit queue of each server instance, it must be a power of two
+ * and at least PREAT_FRAME_EXTENDED_LENGTH
+ */
+#ifndef PREAT_TRANSMIT_BUFFER_SIZE
+#define PREAT_TRANSMIT_BUFFER_SIZE 1024
+#endif
+
+/**
+ * @brief Maximum number of blob bytes carried in each chunk of a bulk transfer
+ */
+#ifndef PREAT_BULK_CHUNK_SIZE
+#define PREAT_BULK_CHUNK_SIZE 128
+#endif
+
+/**
+ * @brief Number of chunks of a bulk transfer that a host can send ahead without waiting the acks
+ */
+#ifndef PREAT_BULK_WINDOW
+#define PREAT_BULK_WINDOW 4
+#endif
+
+/**
+ * @brief Maximum time, in milliseconds, between two bytes of the same frame
+ *
+ * When the gap between bytes is longer the partial frame or bulk chunk received is dropped and the
+ * next byte is taken as the start of a new one.
+ */
+#ifndef PREAT_INTERBYTE_TIMEOUT
+#define PREAT_INTERBYTE_TIMEOUT 20
+#endif
+
+/**
+ * @brief Maximum time, in milliseconds, that a bulk transfer waits for a byte before it is aborted
+ *
+ * When it expires the server returns to receive frames, so a host that stopped sending chunks can
+ * not leave the link blocked in the bulk transfer.
+ */
+#ifndef PREAT_BULK_TIMEOUT
+#define PREAT_BULK_TIMEOUT 500
+#endif
+
+/**
+ * @brief Size in bytes of the circular buffer used by the receive DMA transfer
+ *
+ * The received bytes are moved to the reception queue on each idle line event and each time the
+ * DMA reaches the half or the end of the buffer, so half of the buffer must hold the bytes
+ * received while those events are delayed.
+ */
+#ifndef PREAT_DMA_BUFFER_SIZE
+#define PREAT_DMA_BUFFER_SIZE 256
+#endif
+
+/**
+ * @brief Baud rate used when the server starts and when the link falls back after errors
+ */
+#ifndef PREAT_BAUD_RATE
+#define PREAT_BAUD_RATE 115200
+#endif
+
+/**
+ * @brief Maximum baud rate accepted by the LINK.Baudrate method
+ */
+#ifndef PREAT_BAUD_RATE_MAX
+#define PREAT_BAUD_RATE_MAX 3000000
+#endif
+
+/**
+ * @brief Time, in milliseconds, to receive LINK.Confirm at a new baud rate before rolling back
+ */
+#ifndef PREAT_BAUD_CONFIRM_TIMEOUT
+#define PREAT_BAUD_CONFIRM_TIMEOUT 1000
+#endif
+
+/**
+ * @brief Period, in milliseconds, between calls to ServerCheckLink
+ *
+ * A new baud rate is applied in the first check made at least one period after the response to
+ * LINK.Baudrate was written to the serial port, to let the port send the last bytes.
+ */
+#ifndef PREAT_LINK_CHECK_PERIOD
+#define PREAT_LINK_CHECK_PERIOD 10
+#endif
+
+/**
+ * @brief Number of CRC and framing errors in an error window that make the link fall back
+ */
+#ifndef PREAT_LINK_MAX_ERRORS
+#define PREAT_LINK_MAX_ERRORS 8
+#endif
+
+/**
+ * @brief Duration, in milliseconds, of the window used to count the link errors
+ */
+#ifndef PREAT_LINK_ERROR_WINDOW
+#define PREAT_LINK_ERROR_WINDOW 1000
+#endif
+
 /* === Public data type declarations =========================================================== */
 
 /**
@@ -61,10 +166,75 @@ typedef struct preat_server_s * preat_server_t;
  */
 typedef void (*preat_event_t)(preat_server_t server, void * object);
 
+/**
+ * @brief Operations of a byte stream transport used by a server instance
+ *
+ * The transport notifies the server with ServerReceiveEvent when there are received bytes and
+ * with ServerTransmitEvent when it can send more bytes. The operations are called from those
+ * notifications and from the server task, and they must not block. The bytes accepted by send are
+ * kept unchanged until the next ServerTransmitEvent, so a transport can send them without copies.
+ */
+typedef struct preat_transport_s {
+    /** Copies up to size received bytes to data and returns the number of bytes copied */
+    uint16_t (*receive)(void * port, uint8_t * data, uint16_t size);
+    /** Starts sending up to size bytes of data and returns the number of bytes accepted */
+    uint16_t (*send)(void * port, const uint8_t * data, uint16_t size);
+    /** Changes the baud rate of the transport, NULL if the transport has not a baud rate */
+    bool (*configure)(void * port, uint32_t baud_rate);
+} const * preat_transport_t;
+
+/**
+ * @brief Counters of the link quality of a server instance
+ */
+typedef struct preat_server_counters_s {
+    uint32_t received;  /**< Number of frames queued to be executed */
+    uint32_t crc;       /**< Number of frames and bulk chunks received with a CRC error */
+    uint32_t overflows; /**< Number of frames discarded because the reception queue was full */
+    uint32_t framing;   /**< Number of partial frames dropped and invalid headers skipped */
+} * preat_server_counters_t;
+
 /* === Public variable declarations ============================================================ */
 
 /* === Public function declarations ============================================================ */
 
+/**
+ * @brief Function provided by user to get the current time, it's called from the serial events
+ *
+ * @return  uint32_t    Free running time in milliseconds
+ */
+extern uint32_t ServerTimestamp(void);
+
+/**
+ * @brief Function to create a preat server instance over a byte stream transport
+ *
+ * Each instance has its own buffers and must be served by its own task, which executes the frames
+ * with the instance as the context of PreatExecuteChecked. Starting a server again on a port that
+ * is already in use restarts the instance of that port, ignoring the events that the transport
+ * raises while it is initialized and releasing the blob of a bulk transfer in progress.
+ *
+ * @param   transport       Operations of the transport used by the server
+ * @param   port            Pointer to the transport data, sent as parameter to the operations
+ * @return  preat_server_t  Preat server instance descriptor, NULL if the transport could not be
+ *                          configured or all the PREAT_SERVER_INSTANCES are in use
+ */
+preat_server_t ServerStart(preat_transport_t transport, void * port);
+
+/**
+ * @brief Function called by the transport when there are received bytes
+ *
+ * @param   server      Preat server instance descriptor obtained when starting the server
+ * @param   continued   The transport knows that the line was not idle since the previous event,
+ *                      so the inter-byte timeout is not applied
+ */
+void ServerReceiveEvent(preat_server_t server, bool continued);
+
+/**
+ * @brief Function called by the transport when it can send more bytes
+ *
+ * @param   server  Preat server instance descriptor obtained when starting the server
+ */
+void ServerTransmitEvent(preat_server_t server);
+
 /**
  * @brief Function to create a prear server instance over a serial interface
  *
@@ -75,26 +245,101 @@ typedef void (*preat_event_t)(preat_server_t server, void * object);
  */
 preat_server_t ServerStartSerial(hal_sci_t sci, hal_sci_pins_t serial_pins);
 
+#if defined(PREAT_SERIAL_DMA)
 /**
- * @brief Function to get a command frame from reception buffer
+ * @brief Function to create a prear server instance over a serial interface using DMA transfers
+ *
+ * The bytes are received with a circular DMA transfer and processed when the line goes idle, and
+ * each response is sent with a single DMA transfer. The server is used with the same functions
+ * as the one created by ServerStartSerial. The board must implement the functions in sci_dma.h.
+ *
+ * @param   sci             Serial port descriptor
+ * @param   serial_pins     Pins used by the serial port
+ * @return  preat_server_t  Preat server instance descriptor, NULL if the port could not be started
+ */
+preat_server_t ServerStartSerialDma(hal_sci_t sci, hal_sci_pins_t serial_pins);
+#endif
+
+/**
+ * @brief Function to get the oldest command frame from reception queue
+ *
+ * @remark The server queues up to PREAT_PIPELINE_DEPTH frames, so this function should be called
+ * until it returns false each time a reception event is notified.
  *
  * @param   server  Preat server instance descriptor obtained when starting the server
- * @param   command Pointer to a variable with 64 bytes to copy the received frame
+ * @param   command Pointer to a variable with PREAT_FRAME_EXTENDED_LENGTH bytes to copy the frame
+ * @param   status  Pointer to a variable to store the result of the checks made while the frame
+ *                  was received, to execute it with PreatExecuteChecked using the server as the
+ *                  context. It can be NULL if the caller executes the frame with PreatExecute
  * @return  true    There was a pending frame and it could be copied to the user variable
  * @return  false   There was no pending frame to receive
  */
-bool ServerReceiveCommand(preat_server_t server, uint8_t * command);
+bool ServerReceiveCommand(preat_server_t server, uint8_t * command, preat_error_t * status);
+
+/**
+ * @brief Function to get the link quality counters of a server instance
+ *
+ * @param   server      Preat server instance descriptor obtained when starting the server
+ * @param   counters    Pointer to a variable to copy the current value of the counters
+ */
+void ServerGetCounters(preat_server_t server, preat_server_counters_t counters);
 
 /**
- * @brief Function to put a response in transmition buffer and send it
+ * @brief Function to supervise the link, called periodically by the server task
+ *
+ * Drops the frame in reception when no byte arrived during PREAT_INTERBYTE_TIMEOUT, queuing it
+ * with a framing error to be answered, and aborts a bulk transfer idle for PREAT_BULK_TIMEOUT.
+ * Applies the baud rate requested with LINK.Baudrate once the response was sent, rolls back to
+ * the previous rate if LINK.Confirm is not received in time, and falls back to PREAT_BAUD_RATE
+ * when the CRC and framing errors rise.
+ *
+ * @remark This function should be called every PREAT_LINK_CHECK_PERIOD milliseconds.
+ *
+ * @param   server  Preat server instance descriptor obtained when starting the server
+ */
+void ServerCheckLink(preat_server_t server);
+
+/**
+ * @brief Function to put a response in the transmit queue and start sending it
+ *
+ * The requests of the methods executed in the frame, like a new baud rate or a bulk transfer, are
+ * applied when the response is queued. The function never blocks, the queued frames are sent back
+ * to back from the transmit events of the transport.
  *
  * @param  server   Preat server instance descriptor obtained when starting the server
  * @param  response Pointer to a variable the response frame to transmit
  * @return true     The frame could be queued for transmission successfully
- * @return false    There is a transmission pending and the new frame can be queued
+ * @return false    There is not enough free space in the transmit queue, the frame must be queued
+ *                  again later
  */
 bool ServerTransmitResponse(preat_server_t server, uint8_t * response);
 
+/**
+ * @brief Function to know if the unsolicited frames are held back by a bulk transfer
+ *
+ * The acks of a bulk transfer are sent without framing, so no other frame is sent from the
+ * response to BLOB.Upload until the last ack has been handed to the transport.
+ *
+ * @param  server   Preat server instance descriptor obtained when starting the server
+ * @return true     A bulk transfer is running or its acks are still being sent
+ * @return false    Unsolicited frames can be queued for transmission
+ */
+bool ServerTransmitHeld(preat_server_t server);
+
+/**
+ * @brief Function to put an unsolicited frame, like an event notification, in the transmit queue
+ *
+ * @remark It can be called from any task, but not from an interrupt handler. The frame is copied,
+ * so the caller can reuse its buffer when the function returns.
+ *
+ * @param  server   Preat server instance descriptor obtained when starting the server
+ * @param  frame    Pointer to the frame to transmit, with its length field and CRC
+ * @return true     The frame could be queued for transmission successfully
+ * @return false    There is not enough free space in the transmit queue, or the frame is held
+ *                  back by a bulk transfer, see ServerTransmitHeld
+ */
+bool ServerTransmitFrame(preat_server_t server, const uint8_t * frame);
+
 /**
  * @brief Function to receive an event when a full frame reception is completed
  *
@@ -104,6 +349,16 @@ bool ServerTransmitResponse(preat_server_t server, uint8_t * response);
  */
 void ServerSetEventHandler(preat_server_t server, preat_event_t handler, void * object);
 
+/**
+ * @brief Function to call the event handler of a server when there are frames to send to the host
+ *
+ * @remark It can be called from an interrupt handler, like the one that records a monitored event,
+ * to wake the task that serves the link.
+ *
+ * @param  server   Preat server instance descriptor obtained when starting the server
+ */
+void ServerSignalEvent(preat_server_t server);
+
 /* === End of documentation ==================================================================== */
 
 #ifdef __cplusplus
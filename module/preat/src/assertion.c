@@ -33,9 +33,26 @@ SPDX-License-Identifier: MIT
 /* === Headers files inclusions =============================================================== */
 
 #include "assertion.h"
+#include <stdatomic.h>
 
 /* === Macros definitions ====================================================================== */
 
+/**
+ * @brief Position of the flag of the first condition of an assertion of the pool
+ */
+#define AssertionShift(index)  ((index)*ASSERT_MAX_CONDITIONS)
+
+/**
+ * @brief Flags of the events of all the conditions of an assertion of the pool
+ */
+#define AssertionEvents(index)                                                                     \
+    (((event_flags_t)(1u << ASSERT_MAX_CONDITIONS) - 1) << AssertionShift(index))
+
+/**
+ * @brief Flag of the event of a condition of an assertion of the pool
+ */
+#define AssertionEvent(index, condition) ((event_id_t)1 << (AssertionShift(index) + (condition)))
+
 /* === Private data type declarations ========================================================== */
 
 /**
@@ -46,16 +63,33 @@ typedef struct input_handler_s {
     input_state_t state;     /**< Pointer to private structure with input handler state */
 } input_handler_t;
 
+/**
+ * @brief States of an assertion of the pool
+ */
+typedef enum assertion_state_e {
+    ASSERTION_FREE = 0, /**< The assertion is not in use */
+    ASSERTION_DEFINED,  /**< The assertion was started and waits for an output method */
+    ASSERTION_RUNNING,  /**< The output method was called and the events are being evaluated */
+} assertion_state_t;
+
 /**
  * @brief Structure with asertion information
  */
 typedef struct assertion_s {
-    input_handler_t handlers[8]; /**< Array with input handlerd to stop send events */
-    uint32_t delay;              /**< Initial delay that must elapse without receiving events */
-    uint32_t timeout;            /**< Maximum waiting time to receive events */
-    uint8_t declared_inputs;     /**< Number of inputs declared at the start of the assertion */
-    uint8_t defined_inputs;      /**< Number of inputs currently registered on the assertion */
-    bool active;                 /**< Flag to indicate that an assert is started */
+    input_handler_t handlers[ASSERT_MAX_CONDITIONS]; /**< Input handlers to stop send events */
+    uint32_t delay;           /**< Microseconds that must elapse without receiving events */
+    uint32_t timeout;         /**< Microseconds after the delay to wait for the events */
+    uint8_t declared_inputs;  /**< Number of inputs declared at the start of the assertion */
+    uint8_t defined_inputs;   /**< Number of inputs currently registered on the assertion */
+    uint8_t required;         /**< Number of conditions that must occur to verify the assertion */
+    bool ordered;             /**< Flag to require the conditions in the registration order */
+    event_flags_t received;   /**< Events received inside the window since the output method */
+    uint8_t fired;            /**< Conditions stamped since the output method, one bit each */
+    bool background;          /**< Flag to evaluate the assertion without blocking the output */
+    uint32_t start;           /**< Value of PreatTimestamp when the output method was called */
+    uint32_t times[ASSERT_MAX_CONDITIONS]; /**< Microseconds from the output to each condition */
+    assertion_state_t state;  /**< Current state of the assertion */
+    void * owner;             /**< Context that started the assertion, kept to query its results */
 } * assertion_t;
 
 /* === Private variable declarations =========================================================== */
@@ -67,77 +101,520 @@ typedef struct assertion_s {
 /* === Private variable definitions ============================================================ */
 
 /**
- * @brief Variable with asertion information
+ * @brief Variable with the pool of asertions
+ */
+static struct assertion_s assertions[PREAT_ASSERTIONS] = {0};
+
+/**
+ * @brief Value of PreatTimestamp when each event was first signaled, written by the input handlers
+ */
+static volatile uint32_t stamps[PREAT_ASSERTIONS * ASSERT_MAX_CONDITIONS];
+
+/**
+ * @brief Flags of the events with a valid value in stamps, cleared when an assertion starts
+ */
+static _Atomic event_flags_t stamped;
+
+/**
+ * @brief Flags of the assertions running in background, read by the input handlers to wake owners
  */
-static struct assertion_s assertion[1] = {0};
+static _Atomic uint8_t detached;
 
 /* === Private function implementation ========================================================= */
 
+static bool AssertionDefinedBy(uint8_t index, void * context) {
+    return (assertions[index].state == ASSERTION_DEFINED) && (assertions[index].owner == context);
+}
+
+static bool AssertionDetachedBy(uint8_t index, void * context) {
+    return (atomic_load(&detached) & (1 << index)) && (assertions[index].owner == context);
+}
+
+static event_flags_t AssertionExpected(uint8_t index) {
+    return (((event_flags_t)1 << assertions[index].defined_inputs) - 1) << AssertionShift(index);
+}
+
+static uint8_t AssertionReceived(uint8_t index) {
+    event_flags_t received = assertions[index].received;
+    uint8_t result = 0;
+
+    for (; received != 0; received &= received - 1) {
+        result++;
+    }
+    return result;
+}
+
+/**
+ * @brief Function to store in an assertion the operator received in TEST.Assert
+ *
+ * @param  assertion    Pointer to the assertion to store the operator
+ * @param  code         Operator received in the method
+ * @return true         The operator is valid for the number of conditions declared
+ * @return false        The operator is unknown or requires more conditions than declared
+ */
+static bool AssertionOperator(assertion_t assertion, uint8_t code) {
+    bool result = true;
+
+    code &= ~(ASSERT_OPERATOR_MICROSECONDS | ASSERT_OPERATOR_BACKGROUND);
+    assertion->ordered = (code == ASSERT_OPERATOR_SEQUENCE);
+    if ((code == ASSERT_OPERATOR_AND) || (code == ASSERT_OPERATOR_SEQUENCE)) {
+        assertion->required = assertion->declared_inputs;
+    } else if (code == ASSERT_OPERATOR_OR) {
+        assertion->required = (assertion->declared_inputs != 0) ? 1 : 0;
+    } else if ((code & 0xF0) == ASSERT_OPERATOR_AT_LEAST) {
+        assertion->required = code & 0x0F;
+        result = (assertion->required != 0) && (assertion->required <= assertion->declared_inputs);
+    } else {
+        result = false;
+    }
+    return result;
+}
+
+/**
+ * @brief Function to store in an assertion the time window received in TEST.Assert
+ *
+ * @param  assertion    Pointer to the assertion to store the time window
+ * @param  parameters   Pointer to view with the method parameters
+ * @return true         The window is valid
+ * @return false        The window exceeds ASSERT_MAX_WINDOW microseconds
+ */
+static bool AssertionWindow(assertion_t assertion, preat_parameters_t parameters) {
+    uint64_t scale = (PreatParameterValue(parameters, 3) & ASSERT_OPERATOR_MICROSECONDS) ? 1 : 1000;
+    uint64_t delay = scale * PreatParameterValue(parameters, 0);
+    uint64_t timeout = scale * PreatParameterValue(parameters, 1);
+
+    assertion->delay = (uint32_t)delay;
+    assertion->timeout = (uint32_t)timeout;
+    return (delay + timeout <= ASSERT_MAX_WINDOW);
+}
+
+static void AssertionRelease(assertion_t assertion) {
+    uint8_t index;
+
+    for (index = 0; index < assertion->defined_inputs; index++) {
+        input_handler_t * handler = &(assertion->handlers[index]);
+        handler->cleanup(handler->state, AssertionEvent(assertion - assertions, index));
+    }
+    assertion->state = ASSERTION_FREE;
+}
+
+/**
+ * @brief Function to find the assertion of a context that still has inputs to register
+ */
+static assertion_t AssertionIncomplete(void * context) {
+    assertion_t result = NULL;
+    uint8_t index;
+
+    for (index = 0; index < PREAT_ASSERTIONS; index++) {
+        if (AssertionDefinedBy(index, context) &&
+            (assertions[index].defined_inputs < assertions[index].declared_inputs)) {
+            result = &assertions[index];
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Function to check that the conditions of a sequence occurred in the registration order
+ */
+static bool AssertionInSequence(assertion_t assertion) {
+    event_flags_t received = assertion->received >> AssertionShift(assertion - assertions);
+    bool result = ((received & (received + 1)) == 0);
+    uint8_t condition;
+
+    for (condition = 1; result && ((received >> condition) != 0); condition++) {
+        result = (assertion->times[condition - 1] <= assertion->times[condition]);
+    }
+    return result;
+}
+
+/**
+ * @brief Function to take the events occurred on an assertion using the time they were stamped
+ *
+ * The time of every condition is recorded, even when it occurs outside the window, so the results
+ * of a failed assertion show the latency of each condition.
+ *
+ * @param  index        Position of the assertion in the pool
+ * @param  occurred     Flags with the events occurred, already processed ones are ignored
+ * @return preat_error_t Error code if an event breaks the assertion or PREAT_NO_ERROR
+ */
+static preat_error_t AssertionOccurred(uint8_t index, event_flags_t occurred) {
+    preat_error_t result = PREAT_NO_ERROR;
+    assertion_t assertion = &assertions[index];
+    uint8_t condition;
+    uint32_t time;
+
+    occurred = (occurred & AssertionExpected(index)) >> AssertionShift(index);
+    occurred &= ~assertion->fired;
+    for (condition = 0; condition < assertion->defined_inputs; condition++) {
+        if (occurred & (1 << condition)) {
+            time = stamps[AssertionShift(index) + condition] - assertion->start;
+            assertion->fired |= (1 << condition);
+            assertion->times[condition] = time;
+            if (((int32_t)time < 0) || (time < assertion->delay)) {
+                result = PREAT_TOO_EARLY_ERROR;
+            } else if (time - assertion->delay <= assertion->timeout) {
+                /* Events after the window are ignored and the assertion fails by timeout */
+                assertion->received |= AssertionEvent(index, condition);
+            }
+        }
+    }
+    if ((result == PREAT_NO_ERROR) && assertion->ordered && !AssertionInSequence(assertion)) {
+        result = PREAT_SEQUENCE_ERROR;
+    }
+    return result;
+}
+
+/**
+ * @brief Function to get the microseconds left until the end of the time window of an assertion
+ */
+static uint32_t AssertionRemaining(uint8_t index, uint32_t elapsed) {
+    uint32_t limit = assertions[index].delay;
+
+    /* An assertion without conditions is verified as soon as its delay elapses */
+    if (assertions[index].required != 0) {
+        limit += assertions[index].timeout;
+    }
+    return (limit > elapsed) ? limit - elapsed : 0;
+}
+
+/**
+ * @brief Function to take the events occurred on a running assertion and decide its result
+ *
+ * @param  index        Position of the assertion in the pool
+ * @param  occurred     Flags with the events occurred, already processed ones are ignored
+ * @param  elapsed      Microseconds since the output method, taken before reading the events
+ * @param  error        Pointer to store the result of the assertion when it is finished
+ * @return true         The assertion is finished and its result is stored in error
+ * @return false        The assertion must wait for more events or for the end of its window
+ */
+static bool AssertionUpdate(uint8_t index, event_flags_t occurred, uint32_t elapsed,
+                            preat_error_t * error) {
+    bool result = true;
+
+    *error = AssertionOccurred(index, occurred);
+    if ((*error == PREAT_NO_ERROR) &&
+        ((AssertionReceived(index) < assertions[index].required) ||
+         ((assertions[index].required == 0) && (elapsed < assertions[index].delay)))) {
+        if (AssertionRemaining(index, elapsed) == 0) {
+            *error = PREAT_TIMEOUT_ERROR;
+        } else {
+            result = false;
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Function to evaluate the running assertions of a context until all are verified
+ *
+ * The assertions share a single wait, which ends at the nearest limit of the time windows of the
+ * assertions still pending or when an event arrives, so the total time is the longest window. The
+ * operator of each assertion is evaluated after every wait, so an assertion ends when enough of
+ * its conditions occurred or when a sequence is broken, without waiting for its timeout.
+ *
+ * The events are judged by the time they were stamped in the input handlers, so the wait only
+ * needs the resolution of the system tick. The elapsed time used to declare a timeout is taken
+ * before the wait, so the events stamped before that time are always collected by the wait.
+ *
+ * @param  running      Flags with the assertions of the pool started by the output method
+ * @param  start        Value of PreatTimestamp when the output method was called
+ * @param  failed       Pointer to store the handle of the failed assertion
+ * @return preat_error_t Result of the first assertion that failed or PREAT_NO_ERROR
+ */
+static preat_error_t AssertionsEvaluate(uint8_t running, uint32_t start, uint8_t * failed) {
+    preat_error_t result = PREAT_NO_ERROR;
+    event_flags_t waiting, occurred;
+    uint32_t elapsed, wait, remaining;
+    uint8_t index;
+
+    while ((result == PREAT_NO_ERROR) && (running != 0)) {
+        elapsed = PreatTimestamp() - start;
+        waiting = 0;
+        wait = UINT32_MAX;
+        for (index = 0; index < PREAT_ASSERTIONS; index++) {
+            if (running & (1 << index)) {
+                remaining = AssertionRemaining(index, elapsed);
+                wait = (remaining < wait) ? remaining : wait;
+                waiting |= AssertionExpected(index) & ~assertions[index].received;
+            }
+        }
+
+        occurred = AssertWaitEvents(waiting, wait / 1000 + ((wait % 1000) ? 1 : 0));
+        for (index = 0; (index < PREAT_ASSERTIONS) && (result == PREAT_NO_ERROR); index++) {
+            if ((running & (1 << index)) && AssertionUpdate(index, occurred, elapsed, &result)) {
+                running &= ~(1 << index);
+                if (result != PREAT_NO_ERROR) {
+                    *failed = index;
+                }
+            }
+        }
+    }
+    return result;
+}
+
+/* === Public function implementation ========================================================== */
+
 void AssertClean(void) {
-    assertion->active = false;
+    uint8_t index;
+
+    PreatLock(PREAT_LOCK_ASSERTION);
+    atomic_store(&detached, 0);
+    for (index = 0; index < PREAT_ASSERTIONS; index++) {
+        if (assertions[index].state != ASSERTION_FREE) {
+            AssertionRelease(&assertions[index]);
+        }
+    }
+    PreatUnlock(PREAT_LOCK_ASSERTION);
 }
 
-preat_error_t AssertStart(const preat_parameter_t parameters, uint8_t count) {
-    preat_error_t result = PREAT_REDEFINED_ERROR;
+preat_error_t AssertStart(preat_parameters_t parameters, uint8_t count) {
+    preat_error_t result = PREAT_MEMORY_ERROR;
+    void * context = PreatContext(parameters);
+    uint8_t index;
 
-    if (!assertion->active) {
-        assertion->delay = parameters[0].value;
-        assertion->timeout = parameters[1].value;
-        assertion->declared_inputs = (uint8_t)parameters[2].value;
-        assertion->defined_inputs = 0;
-        assertion->active = true;
-        result = PREAT_NO_ERROR;
+    PreatLock(PREAT_LOCK_ASSERTION);
+    if (AssertionIncomplete(context)) {
+        /* The conditions of an assertion must follow it, before other assertion is started */
+        result = PREAT_REDEFINED_ERROR;
+    } else if ((uint8_t)PreatParameterValue(parameters, 2) > ASSERT_MAX_CONDITIONS) {
+        result = PREAT_PARAMETERS_ERROR;
+    } else {
+        for (index = 0; index < PREAT_ASSERTIONS; index++) {
+            assertion_t assertion = &assertions[index];
+            if (assertion->state == ASSERTION_FREE) {
+                assertion->declared_inputs = (uint8_t)PreatParameterValue(parameters, 2);
+                if (!AssertionOperator(assertion, (uint8_t)PreatParameterValue(parameters, 3)) ||
+                    !AssertionWindow(assertion, parameters)) {
+                    result = PREAT_PARAMETERS_ERROR;
+                    break;
+                }
+                assertion->defined_inputs = 0;
+                assertion->received = 0;
+                assertion->fired = 0;
+                assertion->background =
+                    (PreatParameterValue(parameters, 3) & ASSERT_OPERATOR_BACKGROUND) != 0;
+                assertion->owner = context;
+                assertion->state = ASSERTION_DEFINED;
+                PreatResultAppend(parameters, TYPE_UINT8, index);
+                result = PREAT_NO_ERROR;
+                break;
+            }
+        }
     }
+    PreatUnlock(PREAT_LOCK_ASSERTION);
 
     return result;
 }
 
-event_id_t AssertRegisterEvent(input_cleanup_t cleanup, input_state_t state) {
+event_id_t AssertRegisterEvent(void * context, input_cleanup_t cleanup, input_state_t state) {
     event_id_t result = ASSERT_EVENT_INVALID_ID;
-    if (assertion->defined_inputs < assertion->declared_inputs) {
+    assertion_t assertion;
+
+    PreatLock(PREAT_LOCK_ASSERTION);
+    assertion = AssertionIncomplete(context);
+    if (assertion) {
         input_handler_t * handler = &(assertion->handlers[assertion->defined_inputs]);
-        result = (1 << assertion->defined_inputs);
+        result = AssertionEvent(assertion - assertions, assertion->defined_inputs);
         handler->cleanup = cleanup;
         handler->state = state;
+        assertion->times[assertion->defined_inputs] = 0;
         assertion->defined_inputs++;
     }
+    PreatUnlock(PREAT_LOCK_ASSERTION);
     return result;
 }
 
-preat_error_t AssertExecute(preat_method_t handler, preat_parameter_t parameters, uint8_t count) {
-    preat_error_t result = PREAT_UNDEFINED_ERROR;
-    uint8_t index;
-    event_flags_t expected;
+preat_error_t AssertExecute(preat_method_t handler, preat_parameters_t parameters, uint8_t count) {
+    preat_error_t result = PREAT_NO_ERROR;
+    void * context = PreatContext(parameters);
+    event_flags_t expected = 0;
+    uint8_t index, running = 0, background = 0, failed = 0;
+    uint32_t start = 0;
 
-    if (assertion->defined_inputs == assertion->declared_inputs) {
-        result = handler(parameters, count);
+    PreatLock(PREAT_LOCK_ASSERTION);
+    for (index = 0; index < PREAT_ASSERTIONS; index++) {
+        if (AssertionDefinedBy(index, context)) {
+            if (assertions[index].defined_inputs != assertions[index].declared_inputs) {
+                result = PREAT_UNDEFINED_ERROR;
+            }
+            assertions[index].state = ASSERTION_RUNNING;
+            expected |= AssertionExpected(index);
+            if (assertions[index].background) {
+                background |= (1 << index);
+            } else {
+                running |= (1 << index);
+            }
+        }
     }
+    PreatUnlock(PREAT_LOCK_ASSERTION);
+
     if (result == PREAT_NO_ERROR) {
-        expected = (1 << assertion->defined_inputs) - 1;
-        if (AssertWaitEvents(expected, assertion->delay, false) != 0) {
-            result = PREAT_TOO_EARLY_ERROR;
+        /* Events of the inputs before the output action are discarded */
+        AssertWaitEvents(expected, 0);
+        atomic_fetch_and(&stamped, ~expected);
+        start = PreatTimestamp();
+        for (index = 0; index < PREAT_ASSERTIONS; index++) {
+            if ((running | background) & (1 << index)) {
+                assertions[index].start = start;
+            }
         }
+        atomic_fetch_or(&detached, background);
+        result = handler(parameters, count);
     }
     if (result == PREAT_NO_ERROR) {
-        if (AssertWaitEvents(expected, assertion->timeout, true) != expected) {
-            result = PREAT_TIMEOUT_ERROR;
+        /* The assertions in background are released when AssertNotification reports them */
+        background = 0;
+        result = AssertionsEvaluate(running, start, &failed);
+        if (result != PREAT_NO_ERROR) {
+            PreatResultFailed(parameters, failed);
         }
     }
-    for (index = 0; index < assertion->defined_inputs; index++) {
-        input_handler_t * handler = &(assertion->handlers[index]);
-        handler->cleanup(handler->state);
+
+    PreatLock(PREAT_LOCK_ASSERTION);
+    atomic_fetch_and(&detached, ~background);
+    for (index = 0; index < PREAT_ASSERTIONS; index++) {
+        if ((running | background) & (1 << index)) {
+            AssertionRelease(&assertions[index]);
+        }
+    }
+    PreatUnlock(PREAT_LOCK_ASSERTION);
+
+    return result;
+}
+
+preat_error_t AssertResult(preat_parameters_t parameters, uint8_t count) {
+    preat_error_t result = PREAT_PARAMETERS_ERROR;
+    uint8_t index = (uint8_t)PreatParameterValue(parameters, 0);
+    uint8_t times[sizeof(uint32_t) * ASSERT_MAX_CONDITIONS];
+    uint8_t condition, length = 0;
+    assertion_t assertion;
+
+    PreatLock(PREAT_LOCK_ASSERTION);
+    if (index < PREAT_ASSERTIONS) {
+        assertion = &assertions[index];
+        if ((assertion->state != ASSERTION_FREE) ||
+            (assertion->owner != PreatContext(parameters))) {
+            /* Only the context that executed the assertion can read it, until it is reused */
+            result = PREAT_UNDEFINED_ERROR;
+        } else {
+            for (condition = 0; condition < assertion->declared_inputs; condition++) {
+                times[length++] = (uint8_t)(assertion->times[condition] >> 24);
+                times[length++] = (uint8_t)(assertion->times[condition] >> 16);
+                times[length++] = (uint8_t)(assertion->times[condition] >> 8);
+                times[length++] = (uint8_t)(assertion->times[condition]);
+            }
+            result = PREAT_GENERIC_ERROR;
+            if (PreatResultAppend(parameters, TYPE_UINT8, assertion->declared_inputs) &&
+                PreatResultAppend(parameters, TYPE_UINT8, assertion->fired) &&
+                ((length == 0) || PreatResultAppendBytes(parameters, times, length))) {
+                result = PREAT_NO_ERROR;
+            }
+        }
     }
+    PreatUnlock(PREAT_LOCK_ASSERTION);
+
+    return result;
+}
+
+preat_error_t AssertAbort(preat_parameters_t parameters, uint8_t count) {
+    preat_error_t result = PREAT_PARAMETERS_ERROR;
+    void * context = PreatContext(parameters);
+    uint8_t index = (uint8_t)PreatParameterValue(parameters, 0);
 
-    AssertClean();
+    PreatLock(PREAT_LOCK_ASSERTION);
+    if (index < PREAT_ASSERTIONS) {
+        result = PREAT_UNDEFINED_ERROR;
+        if (AssertionDefinedBy(index, context) || AssertionDetachedBy(index, context)) {
+            atomic_fetch_and(&detached, ~(1 << index));
+            AssertionRelease(&assertions[index]);
+            result = PREAT_NO_ERROR;
+        }
+    }
+    PreatUnlock(PREAT_LOCK_ASSERTION);
 
     return result;
 }
 
-bool AssertIsDefined(void) {
-    return assertion->active;
+bool AssertNotification(void * context, uint8_t * frame) {
+    struct preat_results_s results = {0};
+    struct preat_parameters_s view = {.results = &results};
+    preat_error_t error = PREAT_NO_ERROR;
+    uint32_t elapsed;
+    uint8_t index;
+    bool result = false;
+
+    PreatLock(PREAT_LOCK_ASSERTION);
+    for (index = 0; index < PREAT_ASSERTIONS; index++) {
+        if (AssertionDetachedBy(index, context)) {
+            elapsed = PreatTimestamp() - assertions[index].start;
+            result = AssertionUpdate(index, atomic_load(&stamped), elapsed, &error);
+            if (result) {
+                atomic_fetch_and(&detached, ~(1 << index));
+                AssertionRelease(&assertions[index]);
+                break;
+            }
+        }
+    }
+    if (result) {
+        PreatResultAppend(&view, TYPE_UINT8, index);
+        PreatResultAppend(&view, TYPE_UINT8, error);
+        PreatEncodeNotification(frame, ASSERT_NOTIFY_METHOD, &results);
+    }
+    PreatUnlock(PREAT_LOCK_ASSERTION);
+    return result;
 }
 
-/* === Public function implementation ========================================================== */
+uint32_t AssertPendingTime(void * context) {
+    uint32_t remaining, result = UINT32_MAX;
+    uint8_t index;
+
+    PreatLock(PREAT_LOCK_ASSERTION);
+    for (index = 0; index < PREAT_ASSERTIONS; index++) {
+        if (AssertionDetachedBy(index, context)) {
+            remaining = AssertionRemaining(index, PreatTimestamp() - assertions[index].start);
+            remaining = remaining / 1000 + ((remaining % 1000) ? 1 : 0);
+            result = (remaining < result) ? remaining : result;
+        }
+    }
+    PreatUnlock(PREAT_LOCK_ASSERTION);
+    return result;
+}
+
+void AssertSignalEvents(event_flags_t events) {
+    uint32_t now = PreatTimestamp();
+    event_flags_t pending = events & ~atomic_load(&stamped);
+    uint8_t position, waking, index;
+
+    /* Only the first edge of each condition is stamped, the later ones do not change its time */
+    for (position = 0; (pending >> position) != 0; position++) {
+        if (pending & ((event_flags_t)1 << position)) {
+            stamps[position] = now;
+        }
+    }
+    atomic_fetch_or(&stamped, pending);
+    AssertSetEvent(events);
+
+    /* The assertions in background are evaluated by the task that serves their owner */
+    waking = atomic_load(&detached);
+    for (index = 0; waking != 0; index++, waking >>= 1) {
+        if ((waking & 1) && (pending & AssertionEvents(index))) {
+            AssertWakeContext(assertions[index].owner);
+        }
+    }
+}
+
+bool AssertIsDefined(void * context) {
+    bool result = false;
+    uint8_t index;
+
+    for (index = 0; index < PREAT_ASSERTIONS; index++) {
+        if (AssertionDefinedBy(index, context)) {
+            result = true;
+        }
+    }
+    return result;
+}
 
 /* === End of documentation ==================================================================== */
 
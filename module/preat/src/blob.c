@@ -0,0 +1,289 @@
+/************************************************************************************************
+Copyright (c) 2022-2023, Laboratorio de Microprocesadores
+Facultad de Ciencias Exactas y Tecnología, Universidad Nacional de Tucumán
+https://www.microprocesadores.unt.edu.ar/
+
+Copyright (c) 2022-2023, Esteban Volentini <evolentini@herrera.unt.edu.ar>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** @file
+ ** @brief Binary large objects storage implementation
+ **
+ ** The blobs are stored in a pool of fixed size blocks carved from a static region, so creating
+ ** and destroying a blob takes constant time and the pool never fragments.
+ **
+ ** @addtogroup preat PREAT
+ ** @brief Protocol for Remote Excecution of Automated Tests
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "blob.h"
+#include <stdatomic.h>
+#include <string.h>
+
+/* === Macros definitions ====================================================================== */
+
+/**
+ * @brief Value used in the lists of blocks to indicate the absence of a block
+ */
+#define BLOCK_NONE 0xFF
+
+/**
+ * @brief Number of different identifiers that can be used for blobs
+ */
+#define BLOB_IDS_COUNT 256
+
+/* === Private data type declarations ========================================================== */
+
+/**
+ * @brief Structure with the pool of blocks used to store the blobs
+ */
+typedef struct blob_pool_s {
+    bool initialized;                 /**< Flag to indicate that the free list was built */
+    uint8_t free;                     /**< Index of the first block in the free list */
+    uint8_t available;                /**< Number of blocks in the free list */
+    uint8_t blocks[BLOB_IDS_COUNT];   /**< Block assigned to each blob id, plus one */
+    uint8_t next[BLOB_BLOCKS_COUNT];  /**< Index of the next block in the free list */
+    uint32_t sizes[BLOB_BLOCKS_COUNT]; /**< Size in bytes of the blob stored in each block */
+    _Atomic uint8_t pins[BLOB_BLOCKS_COUNT]; /**< Number of pins held on the blob of each block */
+    uint8_t storage[BLOB_BLOCKS_COUNT][BLOB_BLOCK_SIZE] __attribute__((aligned(4)));
+} * blob_pool_t;
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+static preat_error_t BlobCreate(preat_parameters_t parameters, uint8_t count);
+
+static preat_error_t BlobUpdate(preat_parameters_t parameters, uint8_t count);
+
+static preat_error_t BlobDestroy(preat_parameters_t parameters, uint8_t count);
+
+static preat_error_t BlobAvailable(preat_parameters_t parameters, uint8_t count);
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/**
+ * @brief Variable with the pool of blocks used to store the blobs
+ */
+static struct blob_pool_s pool[1] = {0};
+
+PREAT_METHOD(blob_create, 0x002, false, BlobCreate,
+             PREAT_PARAMETER(0, TYPE_UINT8) | PREAT_PARAMETER(1, TYPE_UINT32));
+
+PREAT_METHOD(blob_update, 0x003, false, BlobUpdate,
+             PREAT_PARAMETER(0, TYPE_UINT8) | PREAT_PARAMETER(1, TYPE_UINT16) |
+                 PREAT_PARAMETER(2, TYPE_BINARY));
+
+PREAT_METHOD(blob_destroy, 0x004, false, BlobDestroy, PREAT_SINGLE_UINT8);
+
+PREAT_METHOD(blob_available, 0x007, false, BlobAvailable, 0);
+
+/* === Private function implementation ========================================================= */
+
+static void PoolInitialize(void) {
+    uint8_t index;
+
+    if (!pool->initialized) {
+        memset(pool->blocks, 0, sizeof(pool->blocks));
+        for (index = 0; index < BLOB_BLOCKS_COUNT; index++) {
+            pool->next[index] = index + 1;
+            atomic_store(&pool->pins[index], 0);
+        }
+        pool->next[BLOB_BLOCKS_COUNT - 1] = BLOCK_NONE;
+        pool->free = 0;
+        pool->available = BLOB_BLOCKS_COUNT;
+        pool->initialized = true;
+    }
+}
+
+static uint8_t BlockAllocate(void) {
+    uint8_t result = pool->free;
+
+    if (result != BLOCK_NONE) {
+        pool->free = pool->next[result];
+        pool->available--;
+    }
+    return result;
+}
+
+static void BlockRelease(uint8_t block) {
+    pool->next[block] = pool->free;
+    pool->free = block;
+    pool->available++;
+}
+
+static uint8_t BlobBlock(uint8_t id) {
+    PoolInitialize();
+    return pool->blocks[id] - 1;
+}
+
+static preat_error_t BlobCreate(preat_parameters_t parameters, uint8_t count) {
+    uint8_t id = (uint8_t)PreatParameterValue(parameters, 0);
+    uint32_t size = PreatParameterValue(parameters, 1);
+    preat_error_t result = PREAT_NO_ERROR;
+    uint8_t block;
+
+    if ((size == 0) || (size > BLOB_BLOCK_SIZE)) {
+        return PREAT_PARAMETERS_ERROR;
+    }
+
+    PreatLock(PREAT_LOCK_BLOBS);
+    if (BlobBlock(id) != BLOCK_NONE) {
+        result = PREAT_REDEFINED_ERROR;
+    } else {
+        block = BlockAllocate();
+        if (block == BLOCK_NONE) {
+            result = PREAT_MEMORY_ERROR;
+        } else {
+            memset(pool->storage[block], 0, size);
+            pool->sizes[block] = size;
+            pool->blocks[id] = block + 1;
+        }
+    }
+    PreatUnlock(PREAT_LOCK_BLOBS);
+    return result;
+}
+
+static preat_error_t BlobUpdate(preat_parameters_t parameters, uint8_t count) {
+    uint16_t offset = (uint16_t)PreatParameterValue(parameters, 1);
+    preat_slice_t data = PreatParameterSlice(parameters, 2);
+    preat_error_t result = PREAT_NO_ERROR;
+    uint8_t block;
+
+    PreatLock(PREAT_LOCK_BLOBS);
+    block = BlobBlock((uint8_t)PreatParameterValue(parameters, 0));
+    if (block == BLOCK_NONE) {
+        result = PREAT_UNDEFINED_ERROR;
+    } else if (atomic_load(&pool->pins[block]) != 0) {
+        result = PREAT_BUSY_ERROR;
+    } else if ((uint32_t)offset + data.length > pool->sizes[block]) {
+        result = PREAT_PARAMETERS_ERROR;
+    } else {
+        memcpy(&pool->storage[block][offset], data.data, data.length);
+    }
+    PreatUnlock(PREAT_LOCK_BLOBS);
+    return result;
+}
+
+static preat_error_t BlobDestroy(preat_parameters_t parameters, uint8_t count) {
+    uint8_t id = (uint8_t)PreatParameterValue(parameters, 0);
+    preat_error_t result = PREAT_NO_ERROR;
+    uint8_t block;
+
+    PreatLock(PREAT_LOCK_BLOBS);
+    block = BlobBlock(id);
+    if (block == BLOCK_NONE) {
+        result = PREAT_UNDEFINED_ERROR;
+    } else if (atomic_load(&pool->pins[block]) != 0) {
+        result = PREAT_BUSY_ERROR;
+    } else {
+        pool->blocks[id] = 0;
+        BlockRelease(block);
+    }
+    PreatUnlock(PREAT_LOCK_BLOBS);
+    return result;
+}
+
+static preat_error_t BlobAvailable(preat_parameters_t parameters, uint8_t count) {
+    uint32_t largest;
+    uint8_t available;
+
+    PreatLock(PREAT_LOCK_BLOBS);
+    PoolInitialize();
+    available = pool->available;
+    PreatUnlock(PREAT_LOCK_BLOBS);
+
+    largest = (available != 0) ? BLOB_BLOCK_SIZE : 0;
+    PreatResultAppend(parameters, TYPE_UINT8, available);
+    PreatResultAppend(parameters, TYPE_UINT32, largest);
+    PreatResultAppend(parameters, TYPE_UINT32, BLOB_BLOCK_SIZE);
+    return PREAT_NO_ERROR;
+}
+
+/* === Public function implementation ========================================================== */
+
+void BlobClean(void) {
+    PreatLock(PREAT_LOCK_BLOBS);
+    pool->initialized = false;
+    PoolInitialize();
+    PreatUnlock(PREAT_LOCK_BLOBS);
+}
+
+uint8_t * BlobStorage(uint8_t id, uint32_t * size) {
+    uint8_t * result = NULL;
+    uint8_t block;
+
+    *size = 0;
+    PreatLock(PREAT_LOCK_BLOBS);
+    block = BlobBlock(id);
+    if (block != BLOCK_NONE) {
+        result = pool->storage[block];
+        *size = pool->sizes[block];
+    }
+    PreatUnlock(PREAT_LOCK_BLOBS);
+    return result;
+}
+
+uint8_t * BlobPin(uint8_t id, uint32_t * size) {
+    uint8_t * result = NULL;
+    uint8_t block;
+
+    *size = 0;
+    PreatLock(PREAT_LOCK_BLOBS);
+    block = BlobBlock(id);
+    if (block != BLOCK_NONE) {
+        atomic_fetch_add(&pool->pins[block], 1);
+        result = pool->storage[block];
+        *size = pool->sizes[block];
+    }
+    PreatUnlock(PREAT_LOCK_BLOBS);
+    return result;
+}
+
+void BlobUnpin(uint8_t id) {
+    /* A pinned blob can not be destroyed, so its block is read without taking the lock */
+    uint8_t block = pool->blocks[id] - 1;
+
+    if ((block != BLOCK_NONE) && (atomic_load(&pool->pins[block]) != 0)) {
+        atomic_fetch_sub(&pool->pins[block], 1);
+    }
+}
+
+const uint8_t * BlobData(uint8_t id, uint32_t * size) {
+    return BlobStorage(id, size);
+}
+
+const uint8_t * BlobParameter(preat_parameters_t parameters, uint8_t index, uint32_t * size) {
+    const uint8_t * result = NULL;
+
+    *size = 0;
+    if (PreatParameterType(parameters, index) == TYPE_BLOB) {
+        result = BlobData((uint8_t)PreatParameterValue(parameters, index), size);
+    }
+    return result;
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
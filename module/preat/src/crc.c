@@ -12,11 +12,41 @@
  *  - XorOut        = 0x0000
  *  - ReflectOut    = False
  *  - Algorithm     = table-driven
+ *
+ * The slicing-by-4, slicing-by-8 and nibble table kernels were added to the generated code, they
+ * produce the same output and one of them is selected at build time with CRC_KERNEL.
  */
 #include "crc.h" /* include the header file generated with pycrc */
 #include <stdint.h>
 #include <stdlib.h>
 
+#if defined(CRC_ALL_KERNELS)
+#define CRC_USE_NIBBLE 1
+#define CRC_USE_TABLE  1
+#define CRC_SLICES     7
+#else
+#define CRC_USE_NIBBLE (CRC_KERNEL == CRC_KERNEL_NIBBLE)
+#define CRC_USE_TABLE  (CRC_KERNEL != CRC_KERNEL_NIBBLE)
+#define CRC_SLICES     ((CRC_KERNEL == CRC_KERNEL_SLICE8) ? 7 : 3)
+#endif
+
+#if defined(CRC_ALL_KERNELS)
+#define CRC_KERNEL_SCOPE
+#else
+#define CRC_KERNEL_SCOPE static
+#endif
+
+#if CRC_USE_NIBBLE
+/**
+ * Static table used for the nibble implementation.
+ */
+static const uint16_t crc_nibble_table[16] = {
+    0x0000, 0xd175, 0x739f, 0xa2ea, 0xe73e, 0x364b, 0x94a1, 0x45d4,
+    0x1f09, 0xce7c, 0x6c96, 0xbde3, 0xf837, 0x2942, 0x8ba8, 0x5add
+};
+#endif
+
+#if CRC_USE_TABLE
 /**
  * Static table used for the table_driven implementation.
  */
@@ -42,16 +72,282 @@ static const crc_t crc_table[256] = {
     0xf8b6, 0x29c3, 0x8b29, 0x5a5c, 0x1f88, 0xcefd, 0x6c17, 0xbd62, 0xa589, 0x74fc, 0xd616, 0x0763,
     0x42b7, 0x93c2, 0x3128, 0xe05d, 0xba80, 0x6bf5, 0xc91f, 0x186a, 0x5dbe, 0x8ccb, 0x2e21, 0xff54,
     0x9b9b, 0x4aee, 0xe804, 0x3971, 0x7ca5, 0xadd0, 0x0f3a, 0xde4f, 0x8492, 0x55e7, 0xf70d, 0x2678,
-    0x63ac, 0xb2d9, 0x1033, 0xc146};
+    0x63ac, 0xb2d9, 0x1033, 0xc146
+};
+#endif
 
-crc_t crc_update(crc_t crc, const void * data, size_t data_len) {
+#if (CRC_KERNEL == CRC_KERNEL_SLICE4) || (CRC_KERNEL == CRC_KERNEL_SLICE8) ||                      \
+    defined(CRC_ALL_KERNELS)
+/**
+ * Static tables used for the slicing implementations, the row k has the crc of each byte value
+ * followed by k + 1 zero bytes. The table of the table_driven implementation is the row zero.
+ */
+static const uint16_t crc_slices[CRC_SLICES][256] = {
+    {
+        0x0000, 0x43ca, 0x8794, 0xc45e, 0xde5d, 0x9d97, 0x59c9, 0x1a03, 0x6dcf, 0x2e05, 0xea5b,
+        0xa991, 0xb392, 0xf058, 0x3406, 0x77cc, 0xdb9e, 0x9854, 0x5c0a, 0x1fc0, 0x05c3, 0x4609,
+        0x8257, 0xc19d, 0xb651, 0xf59b, 0x31c5, 0x720f, 0x680c, 0x2bc6, 0xef98, 0xac52, 0x6649,
+        0x2583, 0xe1dd, 0xa217, 0xb814, 0xfbde, 0x3f80, 0x7c4a, 0x0b86, 0x484c, 0x8c12, 0xcfd8,
+        0xd5db, 0x9611, 0x524f, 0x1185, 0xbdd7, 0xfe1d, 0x3a43, 0x7989, 0x638a, 0x2040, 0xe41e,
+        0xa7d4, 0xd018, 0x93d2, 0x578c, 0x1446, 0x0e45, 0x4d8f, 0x89d1, 0xca1b, 0xcc92, 0x8f58,
+        0x4b06, 0x08cc, 0x12cf, 0x5105, 0x955b, 0xd691, 0xa15d, 0xe297, 0x26c9, 0x6503, 0x7f00,
+        0x3cca, 0xf894, 0xbb5e, 0x170c, 0x54c6, 0x9098, 0xd352, 0xc951, 0x8a9b, 0x4ec5, 0x0d0f,
+        0x7ac3, 0x3909, 0xfd57, 0xbe9d, 0xa49e, 0xe754, 0x230a, 0x60c0, 0xaadb, 0xe911, 0x2d4f,
+        0x6e85, 0x7486, 0x374c, 0xf312, 0xb0d8, 0xc714, 0x84de, 0x4080, 0x034a, 0x1949, 0x5a83,
+        0x9edd, 0xdd17, 0x7145, 0x328f, 0xf6d1, 0xb51b, 0xaf18, 0xecd2, 0x288c, 0x6b46, 0x1c8a,
+        0x5f40, 0x9b1e, 0xd8d4, 0xc2d7, 0x811d, 0x4543, 0x0689, 0x4851, 0x0b9b, 0xcfc5, 0x8c0f,
+        0x960c, 0xd5c6, 0x1198, 0x5252, 0x259e, 0x6654, 0xa20a, 0xe1c0, 0xfbc3, 0xb809, 0x7c57,
+        0x3f9d, 0x93cf, 0xd005, 0x145b, 0x5791, 0x4d92, 0x0e58, 0xca06, 0x89cc, 0xfe00, 0xbdca,
+        0x7994, 0x3a5e, 0x205d, 0x6397, 0xa7c9, 0xe403, 0x2e18, 0x6dd2, 0xa98c, 0xea46, 0xf045,
+        0xb38f, 0x77d1, 0x341b, 0x43d7, 0x001d, 0xc443, 0x8789, 0x9d8a, 0xde40, 0x1a1e, 0x59d4,
+        0xf586, 0xb64c, 0x7212, 0x31d8, 0x2bdb, 0x6811, 0xac4f, 0xef85, 0x9849, 0xdb83, 0x1fdd,
+        0x5c17, 0x4614, 0x05de, 0xc180, 0x824a, 0x84c3, 0xc709, 0x0357, 0x409d, 0x5a9e, 0x1954,
+        0xdd0a, 0x9ec0, 0xe90c, 0xaac6, 0x6e98, 0x2d52, 0x3751, 0x749b, 0xb0c5, 0xf30f, 0x5f5d,
+        0x1c97, 0xd8c9, 0x9b03, 0x8100, 0xc2ca, 0x0694, 0x455e, 0x3292, 0x7158, 0xb506, 0xf6cc,
+        0xeccf, 0xaf05, 0x6b5b, 0x2891, 0xe28a, 0xa140, 0x651e, 0x26d4, 0x3cd7, 0x7f1d, 0xbb43,
+        0xf889, 0x8f45, 0xcc8f, 0x08d1, 0x4b1b, 0x5118, 0x12d2, 0xd68c, 0x9546, 0x3914, 0x7ade,
+        0xbe80, 0xfd4a, 0xe749, 0xa483, 0x60dd, 0x2317, 0x54db, 0x1711, 0xd34f, 0x9085, 0x8a86,
+        0xc94c, 0x0d12, 0x4ed8
+    },
+    {
+        0x0000, 0x90a2, 0xf031, 0x6093, 0x3117, 0xa1b5, 0xc126, 0x5184, 0x622e, 0xf28c, 0x921f,
+        0x02bd, 0x5339, 0xc39b, 0xa308, 0x33aa, 0xc45c, 0x54fe, 0x346d, 0xa4cf, 0xf54b, 0x65e9,
+        0x057a, 0x95d8, 0xa672, 0x36d0, 0x5643, 0xc6e1, 0x9765, 0x07c7, 0x6754, 0xf7f6, 0x59cd,
+        0xc96f, 0xa9fc, 0x395e, 0x68da, 0xf878, 0x98eb, 0x0849, 0x3be3, 0xab41, 0xcbd2, 0x5b70,
+        0x0af4, 0x9a56, 0xfac5, 0x6a67, 0x9d91, 0x0d33, 0x6da0, 0xfd02, 0xac86, 0x3c24, 0x5cb7,
+        0xcc15, 0xffbf, 0x6f1d, 0x0f8e, 0x9f2c, 0xcea8, 0x5e0a, 0x3e99, 0xae3b, 0xb39a, 0x2338,
+        0x43ab, 0xd309, 0x828d, 0x122f, 0x72bc, 0xe21e, 0xd1b4, 0x4116, 0x2185, 0xb127, 0xe0a3,
+        0x7001, 0x1092, 0x8030, 0x77c6, 0xe764, 0x87f7, 0x1755, 0x46d1, 0xd673, 0xb6e0, 0x2642,
+        0x15e8, 0x854a, 0xe5d9, 0x757b, 0x24ff, 0xb45d, 0xd4ce, 0x446c, 0xea57, 0x7af5, 0x1a66,
+        0x8ac4, 0xdb40, 0x4be2, 0x2b71, 0xbbd3, 0x8879, 0x18db, 0x7848, 0xe8ea, 0xb96e, 0x29cc,
+        0x495f, 0xd9fd, 0x2e0b, 0xbea9, 0xde3a, 0x4e98, 0x1f1c, 0x8fbe, 0xef2d, 0x7f8f, 0x4c25,
+        0xdc87, 0xbc14, 0x2cb6, 0x7d32, 0xed90, 0x8d03, 0x1da1, 0xb641, 0x26e3, 0x4670, 0xd6d2,
+        0x8756, 0x17f4, 0x7767, 0xe7c5, 0xd46f, 0x44cd, 0x245e, 0xb4fc, 0xe578, 0x75da, 0x1549,
+        0x85eb, 0x721d, 0xe2bf, 0x822c, 0x128e, 0x430a, 0xd3a8, 0xb33b, 0x2399, 0x1033, 0x8091,
+        0xe002, 0x70a0, 0x2124, 0xb186, 0xd115, 0x41b7, 0xef8c, 0x7f2e, 0x1fbd, 0x8f1f, 0xde9b,
+        0x4e39, 0x2eaa, 0xbe08, 0x8da2, 0x1d00, 0x7d93, 0xed31, 0xbcb5, 0x2c17, 0x4c84, 0xdc26,
+        0x2bd0, 0xbb72, 0xdbe1, 0x4b43, 0x1ac7, 0x8a65, 0xeaf6, 0x7a54, 0x49fe, 0xd95c, 0xb9cf,
+        0x296d, 0x78e9, 0xe84b, 0x88d8, 0x187a, 0x05db, 0x9579, 0xf5ea, 0x6548, 0x34cc, 0xa46e,
+        0xc4fd, 0x545f, 0x67f5, 0xf757, 0x97c4, 0x0766, 0x56e2, 0xc640, 0xa6d3, 0x3671, 0xc187,
+        0x5125, 0x31b6, 0xa114, 0xf090, 0x6032, 0x00a1, 0x9003, 0xa3a9, 0x330b, 0x5398, 0xc33a,
+        0x92be, 0x021c, 0x628f, 0xf22d, 0x5c16, 0xccb4, 0xac27, 0x3c85, 0x6d01, 0xfda3, 0x9d30,
+        0x0d92, 0x3e38, 0xae9a, 0xce09, 0x5eab, 0x0f2f, 0x9f8d, 0xff1e, 0x6fbc, 0x984a, 0x08e8,
+        0x687b, 0xf8d9, 0xa95d, 0x39ff, 0x596c, 0xc9ce, 0xfa64, 0x6ac6, 0x0a55, 0x9af7, 0xcb73,
+        0x5bd1, 0x3b42, 0xabe0
+    },
+    {
+        0x0000, 0xbdf7, 0xaa9b, 0x176c, 0x8443, 0x39b4, 0x2ed8, 0x932f, 0xd9f3, 0x6404, 0x7368,
+        0xce9f, 0x5db0, 0xe047, 0xf72b, 0x4adc, 0x6293, 0xdf64, 0xc808, 0x75ff, 0xe6d0, 0x5b27,
+        0x4c4b, 0xf1bc, 0xbb60, 0x0697, 0x11fb, 0xac0c, 0x3f23, 0x82d4, 0x95b8, 0x284f, 0xc526,
+        0x78d1, 0x6fbd, 0xd24a, 0x4165, 0xfc92, 0xebfe, 0x5609, 0x1cd5, 0xa122, 0xb64e, 0x0bb9,
+        0x9896, 0x2561, 0x320d, 0x8ffa, 0xa7b5, 0x1a42, 0x0d2e, 0xb0d9, 0x23f6, 0x9e01, 0x896d,
+        0x349a, 0x7e46, 0xc3b1, 0xd4dd, 0x692a, 0xfa05, 0x47f2, 0x509e, 0xed69, 0x5b39, 0xe6ce,
+        0xf1a2, 0x4c55, 0xdf7a, 0x628d, 0x75e1, 0xc816, 0x82ca, 0x3f3d, 0x2851, 0x95a6, 0x0689,
+        0xbb7e, 0xac12, 0x11e5, 0x39aa, 0x845d, 0x9331, 0x2ec6, 0xbde9, 0x001e, 0x1772, 0xaa85,
+        0xe059, 0x5dae, 0x4ac2, 0xf735, 0x641a, 0xd9ed, 0xce81, 0x7376, 0x9e1f, 0x23e8, 0x3484,
+        0x8973, 0x1a5c, 0xa7ab, 0xb0c7, 0x0d30, 0x47ec, 0xfa1b, 0xed77, 0x5080, 0xc3af, 0x7e58,
+        0x6934, 0xd4c3, 0xfc8c, 0x417b, 0x5617, 0xebe0, 0x78cf, 0xc538, 0xd254, 0x6fa3, 0x257f,
+        0x9888, 0x8fe4, 0x3213, 0xa13c, 0x1ccb, 0x0ba7, 0xb650, 0xb672, 0x0b85, 0x1ce9, 0xa11e,
+        0x3231, 0x8fc6, 0x98aa, 0x255d, 0x6f81, 0xd276, 0xc51a, 0x78ed, 0xebc2, 0x5635, 0x4159,
+        0xfcae, 0xd4e1, 0x6916, 0x7e7a, 0xc38d, 0x50a2, 0xed55, 0xfa39, 0x47ce, 0x0d12, 0xb0e5,
+        0xa789, 0x1a7e, 0x8951, 0x34a6, 0x23ca, 0x9e3d, 0x7354, 0xcea3, 0xd9cf, 0x6438, 0xf717,
+        0x4ae0, 0x5d8c, 0xe07b, 0xaaa7, 0x1750, 0x003c, 0xbdcb, 0x2ee4, 0x9313, 0x847f, 0x3988,
+        0x11c7, 0xac30, 0xbb5c, 0x06ab, 0x9584, 0x2873, 0x3f1f, 0x82e8, 0xc834, 0x75c3, 0x62af,
+        0xdf58, 0x4c77, 0xf180, 0xe6ec, 0x5b1b, 0xed4b, 0x50bc, 0x47d0, 0xfa27, 0x6908, 0xd4ff,
+        0xc393, 0x7e64, 0x34b8, 0x894f, 0x9e23, 0x23d4, 0xb0fb, 0x0d0c, 0x1a60, 0xa797, 0x8fd8,
+        0x322f, 0x2543, 0x98b4, 0x0b9b, 0xb66c, 0xa100, 0x1cf7, 0x562b, 0xebdc, 0xfcb0, 0x4147,
+        0xd268, 0x6f9f, 0x78f3, 0xc504, 0x286d, 0x959a, 0x82f6, 0x3f01, 0xac2e, 0x11d9, 0x06b5,
+        0xbb42, 0xf19e, 0x4c69, 0x5b05, 0xe6f2, 0x75dd, 0xc82a, 0xdf46, 0x62b1, 0x4afe, 0xf709,
+        0xe065, 0x5d92, 0xcebd, 0x734a, 0x6426, 0xd9d1, 0x930d, 0x2efa, 0x3996, 0x8461, 0x174e,
+        0xaab9, 0xbdd5, 0x0022
+    },
+#if CRC_SLICES > 3
+    {
+        0x0000, 0xbd91, 0xaa57, 0x17c6, 0x85db, 0x384a, 0x2f8c, 0x921d, 0xdac3, 0x6752, 0x7094,
+        0xcd05, 0x5f18, 0xe289, 0xf54f, 0x48de, 0x64f3, 0xd962, 0xcea4, 0x7335, 0xe128, 0x5cb9,
+        0x4b7f, 0xf6ee, 0xbe30, 0x03a1, 0x1467, 0xa9f6, 0x3beb, 0x867a, 0x91bc, 0x2c2d, 0xc9e6,
+        0x7477, 0x63b1, 0xde20, 0x4c3d, 0xf1ac, 0xe66a, 0x5bfb, 0x1325, 0xaeb4, 0xb972, 0x04e3,
+        0x96fe, 0x2b6f, 0x3ca9, 0x8138, 0xad15, 0x1084, 0x0742, 0xbad3, 0x28ce, 0x955f, 0x8299,
+        0x3f08, 0x77d6, 0xca47, 0xdd81, 0x6010, 0xf20d, 0x4f9c, 0x585a, 0xe5cb, 0x42b9, 0xff28,
+        0xe8ee, 0x557f, 0xc762, 0x7af3, 0x6d35, 0xd0a4, 0x987a, 0x25eb, 0x322d, 0x8fbc, 0x1da1,
+        0xa030, 0xb7f6, 0x0a67, 0x264a, 0x9bdb, 0x8c1d, 0x318c, 0xa391, 0x1e00, 0x09c6, 0xb457,
+        0xfc89, 0x4118, 0x56de, 0xeb4f, 0x7952, 0xc4c3, 0xd305, 0x6e94, 0x8b5f, 0x36ce, 0x2108,
+        0x9c99, 0x0e84, 0xb315, 0xa4d3, 0x1942, 0x519c, 0xec0d, 0xfbcb, 0x465a, 0xd447, 0x69d6,
+        0x7e10, 0xc381, 0xefac, 0x523d, 0x45fb, 0xf86a, 0x6a77, 0xd7e6, 0xc020, 0x7db1, 0x356f,
+        0x88fe, 0x9f38, 0x22a9, 0xb0b4, 0x0d25, 0x1ae3, 0xa772, 0x8572, 0x38e3, 0x2f25, 0x92b4,
+        0x00a9, 0xbd38, 0xaafe, 0x176f, 0x5fb1, 0xe220, 0xf5e6, 0x4877, 0xda6a, 0x67fb, 0x703d,
+        0xcdac, 0xe181, 0x5c10, 0x4bd6, 0xf647, 0x645a, 0xd9cb, 0xce0d, 0x739c, 0x3b42, 0x86d3,
+        0x9115, 0x2c84, 0xbe99, 0x0308, 0x14ce, 0xa95f, 0x4c94, 0xf105, 0xe6c3, 0x5b52, 0xc94f,
+        0x74de, 0x6318, 0xde89, 0x9657, 0x2bc6, 0x3c00, 0x8191, 0x138c, 0xae1d, 0xb9db, 0x044a,
+        0x2867, 0x95f6, 0x8230, 0x3fa1, 0xadbc, 0x102d, 0x07eb, 0xba7a, 0xf2a4, 0x4f35, 0x58f3,
+        0xe562, 0x777f, 0xcaee, 0xdd28, 0x60b9, 0xc7cb, 0x7a5a, 0x6d9c, 0xd00d, 0x4210, 0xff81,
+        0xe847, 0x55d6, 0x1d08, 0xa099, 0xb75f, 0x0ace, 0x98d3, 0x2542, 0x3284, 0x8f15, 0xa338,
+        0x1ea9, 0x096f, 0xb4fe, 0x26e3, 0x9b72, 0x8cb4, 0x3125, 0x79fb, 0xc46a, 0xd3ac, 0x6e3d,
+        0xfc20, 0x41b1, 0x5677, 0xebe6, 0x0e2d, 0xb3bc, 0xa47a, 0x19eb, 0x8bf6, 0x3667, 0x21a1,
+        0x9c30, 0xd4ee, 0x697f, 0x7eb9, 0xc328, 0x5135, 0xeca4, 0xfb62, 0x46f3, 0x6ade, 0xd74f,
+        0xc089, 0x7d18, 0xef05, 0x5294, 0x4552, 0xf8c3, 0xb01d, 0x0d8c, 0x1a4a, 0xa7db, 0x35c6,
+        0x8857, 0x9f91, 0x2200
+    },
+    {
+        0x0000, 0xdb91, 0x6657, 0xbdc6, 0xccae, 0x173f, 0xaaf9, 0x7168, 0x4829, 0x93b8, 0x2e7e,
+        0xf5ef, 0x8487, 0x5f16, 0xe2d0, 0x3941, 0x9052, 0x4bc3, 0xf605, 0x2d94, 0x5cfc, 0x876d,
+        0x3aab, 0xe13a, 0xd87b, 0x03ea, 0xbe2c, 0x65bd, 0x14d5, 0xcf44, 0x7282, 0xa913, 0xf1d1,
+        0x2a40, 0x9786, 0x4c17, 0x3d7f, 0xe6ee, 0x5b28, 0x80b9, 0xb9f8, 0x6269, 0xdfaf, 0x043e,
+        0x7556, 0xaec7, 0x1301, 0xc890, 0x6183, 0xba12, 0x07d4, 0xdc45, 0xad2d, 0x76bc, 0xcb7a,
+        0x10eb, 0x29aa, 0xf23b, 0x4ffd, 0x946c, 0xe504, 0x3e95, 0x8353, 0x58c2, 0x32d7, 0xe946,
+        0x5480, 0x8f11, 0xfe79, 0x25e8, 0x982e, 0x43bf, 0x7afe, 0xa16f, 0x1ca9, 0xc738, 0xb650,
+        0x6dc1, 0xd007, 0x0b96, 0xa285, 0x7914, 0xc4d2, 0x1f43, 0x6e2b, 0xb5ba, 0x087c, 0xd3ed,
+        0xeaac, 0x313d, 0x8cfb, 0x576a, 0x2602, 0xfd93, 0x4055, 0x9bc4, 0xc306, 0x1897, 0xa551,
+        0x7ec0, 0x0fa8, 0xd439, 0x69ff, 0xb26e, 0x8b2f, 0x50be, 0xed78, 0x36e9, 0x4781, 0x9c10,
+        0x21d6, 0xfa47, 0x5354, 0x88c5, 0x3503, 0xee92, 0x9ffa, 0x446b, 0xf9ad, 0x223c, 0x1b7d,
+        0xc0ec, 0x7d2a, 0xa6bb, 0xd7d3, 0x0c42, 0xb184, 0x6a15, 0x65ae, 0xbe3f, 0x03f9, 0xd868,
+        0xa900, 0x7291, 0xcf57, 0x14c6, 0x2d87, 0xf616, 0x4bd0, 0x9041, 0xe129, 0x3ab8, 0x877e,
+        0x5cef, 0xf5fc, 0x2e6d, 0x93ab, 0x483a, 0x3952, 0xe2c3, 0x5f05, 0x8494, 0xbdd5, 0x6644,
+        0xdb82, 0x0013, 0x717b, 0xaaea, 0x172c, 0xccbd, 0x947f, 0x4fee, 0xf228, 0x29b9, 0x58d1,
+        0x8340, 0x3e86, 0xe517, 0xdc56, 0x07c7, 0xba01, 0x6190, 0x10f8, 0xcb69, 0x76af, 0xad3e,
+        0x042d, 0xdfbc, 0x627a, 0xb9eb, 0xc883, 0x1312, 0xaed4, 0x7545, 0x4c04, 0x9795, 0x2a53,
+        0xf1c2, 0x80aa, 0x5b3b, 0xe6fd, 0x3d6c, 0x5779, 0x8ce8, 0x312e, 0xeabf, 0x9bd7, 0x4046,
+        0xfd80, 0x2611, 0x1f50, 0xc4c1, 0x7907, 0xa296, 0xd3fe, 0x086f, 0xb5a9, 0x6e38, 0xc72b,
+        0x1cba, 0xa17c, 0x7aed, 0x0b85, 0xd014, 0x6dd2, 0xb643, 0x8f02, 0x5493, 0xe955, 0x32c4,
+        0x43ac, 0x983d, 0x25fb, 0xfe6a, 0xa6a8, 0x7d39, 0xc0ff, 0x1b6e, 0x6a06, 0xb197, 0x0c51,
+        0xd7c0, 0xee81, 0x3510, 0x88d6, 0x5347, 0x222f, 0xf9be, 0x4478, 0x9fe9, 0x36fa, 0xed6b,
+        0x50ad, 0x8b3c, 0xfa54, 0x21c5, 0x9c03, 0x4792, 0x7ed3, 0xa542, 0x1884, 0xc315, 0xb27d,
+        0x69ec, 0xd42a, 0x0fbb
+    },
+    {
+        0x0000, 0xcb5c, 0x47cd, 0x8c91, 0x8f9a, 0x44c6, 0xc857, 0x030b, 0xce41, 0x051d, 0x898c,
+        0x42d0, 0x41db, 0x8a87, 0x0616, 0xcd4a, 0x4df7, 0x86ab, 0x0a3a, 0xc166, 0xc26d, 0x0931,
+        0x85a0, 0x4efc, 0x83b6, 0x48ea, 0xc47b, 0x0f27, 0x0c2c, 0xc770, 0x4be1, 0x80bd, 0x9bee,
+        0x50b2, 0xdc23, 0x177f, 0x1474, 0xdf28, 0x53b9, 0x98e5, 0x55af, 0x9ef3, 0x1262, 0xd93e,
+        0xda35, 0x1169, 0x9df8, 0x56a4, 0xd619, 0x1d45, 0x91d4, 0x5a88, 0x5983, 0x92df, 0x1e4e,
+        0xd512, 0x1858, 0xd304, 0x5f95, 0x94c9, 0x97c2, 0x5c9e, 0xd00f, 0x1b53, 0xe6a9, 0x2df5,
+        0xa164, 0x6a38, 0x6933, 0xa26f, 0x2efe, 0xe5a2, 0x28e8, 0xe3b4, 0x6f25, 0xa479, 0xa772,
+        0x6c2e, 0xe0bf, 0x2be3, 0xab5e, 0x6002, 0xec93, 0x27cf, 0x24c4, 0xef98, 0x6309, 0xa855,
+        0x651f, 0xae43, 0x22d2, 0xe98e, 0xea85, 0x21d9, 0xad48, 0x6614, 0x7d47, 0xb61b, 0x3a8a,
+        0xf1d6, 0xf2dd, 0x3981, 0xb510, 0x7e4c, 0xb306, 0x785a, 0xf4cb, 0x3f97, 0x3c9c, 0xf7c0,
+        0x7b51, 0xb00d, 0x30b0, 0xfbec, 0x777d, 0xbc21, 0xbf2a, 0x7476, 0xf8e7, 0x33bb, 0xfef1,
+        0x35ad, 0xb93c, 0x7260, 0x716b, 0xba37, 0x36a6, 0xfdfa, 0x1c27, 0xd77b, 0x5bea, 0x90b6,
+        0x93bd, 0x58e1, 0xd470, 0x1f2c, 0xd266, 0x193a, 0x95ab, 0x5ef7, 0x5dfc, 0x96a0, 0x1a31,
+        0xd16d, 0x51d0, 0x9a8c, 0x161d, 0xdd41, 0xde4a, 0x1516, 0x9987, 0x52db, 0x9f91, 0x54cd,
+        0xd85c, 0x1300, 0x100b, 0xdb57, 0x57c6, 0x9c9a, 0x87c9, 0x4c95, 0xc004, 0x0b58, 0x0853,
+        0xc30f, 0x4f9e, 0x84c2, 0x4988, 0x82d4, 0x0e45, 0xc519, 0xc612, 0x0d4e, 0x81df, 0x4a83,
+        0xca3e, 0x0162, 0x8df3, 0x46af, 0x45a4, 0x8ef8, 0x0269, 0xc935, 0x047f, 0xcf23, 0x43b2,
+        0x88ee, 0x8be5, 0x40b9, 0xcc28, 0x0774, 0xfa8e, 0x31d2, 0xbd43, 0x761f, 0x7514, 0xbe48,
+        0x32d9, 0xf985, 0x34cf, 0xff93, 0x7302, 0xb85e, 0xbb55, 0x7009, 0xfc98, 0x37c4, 0xb779,
+        0x7c25, 0xf0b4, 0x3be8, 0x38e3, 0xf3bf, 0x7f2e, 0xb472, 0x7938, 0xb264, 0x3ef5, 0xf5a9,
+        0xf6a2, 0x3dfe, 0xb16f, 0x7a33, 0x6160, 0xaa3c, 0x26ad, 0xedf1, 0xeefa, 0x25a6, 0xa937,
+        0x626b, 0xaf21, 0x647d, 0xe8ec, 0x23b0, 0x20bb, 0xebe7, 0x6776, 0xac2a, 0x2c97, 0xe7cb,
+        0x6b5a, 0xa006, 0xa30d, 0x6851, 0xe4c0, 0x2f9c, 0xe2d6, 0x298a, 0xa51b, 0x6e47, 0x6d4c,
+        0xa610, 0x2a81, 0xe1dd
+    },
+    {
+        0x0000, 0x384e, 0x709c, 0x48d2, 0xe138, 0xd976, 0x91a4, 0xa9ea, 0x1305, 0x2b4b, 0x6399,
+        0x5bd7, 0xf23d, 0xca73, 0x82a1, 0xbaef, 0x260a, 0x1e44, 0x5696, 0x6ed8, 0xc732, 0xff7c,
+        0xb7ae, 0x8fe0, 0x350f, 0x0d41, 0x4593, 0x7ddd, 0xd437, 0xec79, 0xa4ab, 0x9ce5, 0x4c14,
+        0x745a, 0x3c88, 0x04c6, 0xad2c, 0x9562, 0xddb0, 0xe5fe, 0x5f11, 0x675f, 0x2f8d, 0x17c3,
+        0xbe29, 0x8667, 0xceb5, 0xf6fb, 0x6a1e, 0x5250, 0x1a82, 0x22cc, 0x8b26, 0xb368, 0xfbba,
+        0xc3f4, 0x791b, 0x4155, 0x0987, 0x31c9, 0x9823, 0xa06d, 0xe8bf, 0xd0f1, 0x9828, 0xa066,
+        0xe8b4, 0xd0fa, 0x7910, 0x415e, 0x098c, 0x31c2, 0x8b2d, 0xb363, 0xfbb1, 0xc3ff, 0x6a15,
+        0x525b, 0x1a89, 0x22c7, 0xbe22, 0x866c, 0xcebe, 0xf6f0, 0x5f1a, 0x6754, 0x2f86, 0x17c8,
+        0xad27, 0x9569, 0xddbb, 0xe5f5, 0x4c1f, 0x7451, 0x3c83, 0x04cd, 0xd43c, 0xec72, 0xa4a0,
+        0x9cee, 0x3504, 0x0d4a, 0x4598, 0x7dd6, 0xc739, 0xff77, 0xb7a5, 0x8feb, 0x2601, 0x1e4f,
+        0x569d, 0x6ed3, 0xf236, 0xca78, 0x82aa, 0xbae4, 0x130e, 0x2b40, 0x6392, 0x5bdc, 0xe133,
+        0xd97d, 0x91af, 0xa9e1, 0x000b, 0x3845, 0x7097, 0x48d9, 0xe125, 0xd96b, 0x91b9, 0xa9f7,
+        0x001d, 0x3853, 0x7081, 0x48cf, 0xf220, 0xca6e, 0x82bc, 0xbaf2, 0x1318, 0x2b56, 0x6384,
+        0x5bca, 0xc72f, 0xff61, 0xb7b3, 0x8ffd, 0x2617, 0x1e59, 0x568b, 0x6ec5, 0xd42a, 0xec64,
+        0xa4b6, 0x9cf8, 0x3512, 0x0d5c, 0x458e, 0x7dc0, 0xad31, 0x957f, 0xddad, 0xe5e3, 0x4c09,
+        0x7447, 0x3c95, 0x04db, 0xbe34, 0x867a, 0xcea8, 0xf6e6, 0x5f0c, 0x6742, 0x2f90, 0x17de,
+        0x8b3b, 0xb375, 0xfba7, 0xc3e9, 0x6a03, 0x524d, 0x1a9f, 0x22d1, 0x983e, 0xa070, 0xe8a2,
+        0xd0ec, 0x7906, 0x4148, 0x099a, 0x31d4, 0x790d, 0x4143, 0x0991, 0x31df, 0x9835, 0xa07b,
+        0xe8a9, 0xd0e7, 0x6a08, 0x5246, 0x1a94, 0x22da, 0x8b30, 0xb37e, 0xfbac, 0xc3e2, 0x5f07,
+        0x6749, 0x2f9b, 0x17d5, 0xbe3f, 0x8671, 0xcea3, 0xf6ed, 0x4c02, 0x744c, 0x3c9e, 0x04d0,
+        0xad3a, 0x9574, 0xdda6, 0xe5e8, 0x3519, 0x0d57, 0x4585, 0x7dcb, 0xd421, 0xec6f, 0xa4bd,
+        0x9cf3, 0x261c, 0x1e52, 0x5680, 0x6ece, 0xc724, 0xff6a, 0xb7b8, 0x8ff6, 0x1313, 0x2b5d,
+        0x638f, 0x5bc1, 0xf22b, 0xca65, 0x82b7, 0xbaf9, 0x0016, 0x3858, 0x708a, 0x48c4, 0xe12e,
+        0xd960, 0x91b2, 0xa9fc
+    }
+#endif
+};
+#endif
+
+#if CRC_USE_TABLE
+static inline crc_t crc_update_byte(crc_t crc, unsigned char data) {
+    return (crc_table[((crc >> 8) ^ data) & 0xff] ^ (crc << 8)) & 0xffff;
+}
+#endif
+
+#if (CRC_KERNEL == CRC_KERNEL_NIBBLE) || defined(CRC_ALL_KERNELS)
+CRC_KERNEL_SCOPE crc_t crc_update_nibble(crc_t crc, const void * data, size_t data_len) {
+    const unsigned char * d = (const unsigned char *)data;
+
+    while (data_len--) {
+        crc = (crc_nibble_table[((crc >> 12) ^ (*d >> 4)) & 0x0f] ^ (crc << 4)) & 0xffff;
+        crc = (crc_nibble_table[((crc >> 12) ^ *d) & 0x0f] ^ (crc << 4)) & 0xffff;
+        d++;
+    }
+    return crc & 0xffff;
+}
+#endif
+
+#if (CRC_KERNEL == CRC_KERNEL_TABLE) || defined(CRC_ALL_KERNELS)
+CRC_KERNEL_SCOPE crc_t crc_update_table(crc_t crc, const void * data, size_t data_len) {
     const unsigned char * d = (const unsigned char *)data;
 
     while (data_len--) {
-        unsigned int tbl_idx;
-        tbl_idx = ((crc >> 8) ^ *d) & 0xff;
-        crc = (crc_table[tbl_idx] ^ (crc << 8)) & 0xffff;
+        crc = crc_update_byte(crc, *d);
         d++;
     }
     return crc & 0xffff;
 }
+#endif
+
+#if (CRC_KERNEL == CRC_KERNEL_SLICE4) || defined(CRC_ALL_KERNELS)
+CRC_KERNEL_SCOPE crc_t crc_update_slice4(crc_t crc, const void * data, size_t data_len) {
+    const unsigned char * d = (const unsigned char *)data;
+
+    crc &= 0xffff;
+    while (data_len >= 4) {
+        crc = crc_slices[2][(crc >> 8) ^ d[0]] ^ crc_slices[1][(crc ^ d[1]) & 0xff] ^
+              crc_slices[0][d[2]] ^ crc_table[d[3]];
+        d += 4;
+        data_len -= 4;
+    }
+    while (data_len--) {
+        crc = crc_update_byte(crc, *d);
+        d++;
+    }
+    return crc & 0xffff;
+}
+#endif
+
+#if (CRC_KERNEL == CRC_KERNEL_SLICE8) || defined(CRC_ALL_KERNELS)
+CRC_KERNEL_SCOPE crc_t crc_update_slice8(crc_t crc, const void * data, size_t data_len) {
+    const unsigned char * d = (const unsigned char *)data;
+
+    crc &= 0xffff;
+    while (data_len >= 8) {
+        crc = crc_slices[6][(crc >> 8) ^ d[0]] ^ crc_slices[5][(crc ^ d[1]) & 0xff] ^
+              crc_slices[4][d[2]] ^ crc_slices[3][d[3]] ^ crc_slices[2][d[4]] ^
+              crc_slices[1][d[5]] ^ crc_slices[0][d[6]] ^ crc_table[d[7]];
+        d += 8;
+        data_len -= 8;
+    }
+    while (data_len--) {
+        crc = crc_update_byte(crc, *d);
+        d++;
+    }
+    return crc & 0xffff;
+}
+#endif
+
+crc_t crc_update(crc_t crc, const void * data, size_t data_len) {
+#if CRC_KERNEL == CRC_KERNEL_NIBBLE
+    return crc_update_nibble(crc, data, data_len);
+#elif CRC_KERNEL == CRC_KERNEL_SLICE4
+    return crc_update_slice4(crc, data, data_len);
+#elif CRC_KERNEL == CRC_KERNEL_SLICE8
+    return crc_update_slice8(crc, data, data_len);
+#else
+    return crc_update_table(crc, data, data_len);
+#endif
+}
@@ -0,0 +1,191 @@
+/************************************************************************************************
+Copyright (c) 2022-2023, Laboratorio de Microprocesadores
+Facultad de Ciencias Exactas y Tecnología, Universidad Nacional de Tucumán
+https://www.microprocesadores.unt.edu.ar/
+
+Copyright (c) 2022-2023, Esteban Volentini <evolentini@herrera.unt.edu.ar>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** @file
+ ** @brief Monitor of inputs events implementation
+ **
+ ** @addtogroup preat PREAT
+ ** @brief Protocol for Remote Excecution of Automated Tests
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "monitor.h"
+#include <stdatomic.h>
+#include <stddef.h>
+
+/* === Macros definitions ====================================================================== */
+
+/* === Private data type declarations ========================================================== */
+
+/**
+ * @brief Edge of an input recorded by the monitor
+ */
+typedef struct monitor_event_s {
+    uint32_t timestamp; /**< Value of PreatTimestamp when the edge was recorded */
+    uint8_t source;     /**< Number of the input, with MONITOR_RISSING_EDGE for a rissing edge */
+} * monitor_event_t;
+
+/**
+ * @brief Structure with the monitor information
+ *
+ * The interrupt handlers of the inputs are the only writers of the head index and the lost
+ * counter, and the task that serves the owner is the only writer of the tail index and the
+ * reported counter, so the events are exchanged without disabling the interrupts.
+ */
+typedef struct monitor_s {
+    volatile bool active;   /**< Flag to indicate that the monitor is started */
+    void * volatile owner;  /**< Context that started the monitor */
+    volatile uint16_t head; /**< Count of events recorded, written by the interrupt handlers */
+    volatile uint16_t tail; /**< Count of events notified, written by the owner task */
+    volatile uint32_t lost; /**< Count of events discarded because there was no free space */
+    uint32_t reported;      /**< Count of discarded events already notified */
+    struct monitor_event_s events[PREAT_MONITOR_EVENTS]; /**< Events waiting to be notified */
+} * monitor_t;
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/**
+ * @brief Variable with the monitor information
+ */
+static struct monitor_s monitor[1] = {0};
+
+/* === Private function implementation ========================================================= */
+
+static void MonitorDiscard(void) {
+    monitor->tail = monitor->head;
+    monitor->reported = monitor->lost;
+}
+
+/* === Public function implementation ========================================================== */
+
+bool MonitorStart(void * context) {
+    bool result = false;
+
+    PreatLock(PREAT_LOCK_MONITOR);
+    if (!monitor->active) {
+        MonitorDiscard();
+        monitor->owner = context;
+        atomic_signal_fence(memory_order_release);
+        monitor->active = true;
+    }
+    result = (monitor->owner == context);
+    PreatUnlock(PREAT_LOCK_MONITOR);
+    return result;
+}
+
+bool MonitorStop(void * context) {
+    bool result = true;
+
+    PreatLock(PREAT_LOCK_MONITOR);
+    if (monitor->active) {
+        result = (monitor->owner == context);
+        if (result) {
+            monitor->active = false;
+            monitor->owner = NULL;
+            MonitorDiscard();
+        }
+    }
+    PreatUnlock(PREAT_LOCK_MONITOR);
+    return result;
+}
+
+void MonitorRecord(uint8_t source, bool rissing) {
+    monitor_event_t event;
+    uint16_t head = monitor->head;
+
+    if (!monitor->active) {
+        return;
+    }
+    if ((uint16_t)(head - monitor->tail) >= PREAT_MONITOR_EVENTS) {
+        monitor->lost++;
+        return;
+    }
+    event = &(monitor->events[head % PREAT_MONITOR_EVENTS]);
+    event->timestamp = PreatTimestamp();
+    event->source = rissing ? (source | MONITOR_RISSING_EDGE) : (source & ~MONITOR_RISSING_EDGE);
+    atomic_signal_fence(memory_order_release);
+    monitor->head = head + 1;
+    if (head == monitor->tail) {
+        MonitorSetEvent(monitor->owner);
+    }
+}
+
+bool MonitorNotification(void * context, uint8_t * frame) {
+    struct preat_results_s results = {0};
+    struct preat_parameters_s view = {.results = &results};
+    uint8_t data[MONITOR_FRAME_EVENTS * MONITOR_EVENT_SIZE];
+    uint8_t length = 0;
+    uint32_t base, offset, lost;
+    uint16_t tail;
+    monitor_event_t event;
+    bool result;
+
+    PreatLock(PREAT_LOCK_MONITOR);
+    tail = monitor->tail;
+    lost = monitor->lost - monitor->reported;
+    result = monitor->active && (monitor->owner == context) &&
+             ((tail != monitor->head) || (lost != 0));
+    if (result) {
+        atomic_signal_fence(memory_order_acquire);
+        base = (tail != monitor->head) ? monitor->events[tail % PREAT_MONITOR_EVENTS].timestamp
+                                       : PreatTimestamp();
+        while ((tail != monitor->head) && (length < sizeof(data))) {
+            event = &(monitor->events[tail % PREAT_MONITOR_EVENTS]);
+            offset = event->timestamp - base;
+            if (offset > MONITOR_MAX_OFFSET) {
+                break;
+            }
+            data[length++] = event->source;
+            data[length++] = (uint8_t)(offset >> 16);
+            data[length++] = (uint8_t)(offset >> 8);
+            data[length++] = (uint8_t)offset;
+            tail++;
+        }
+        lost = (lost > UINT8_MAX) ? UINT8_MAX : lost;
+        monitor->reported += lost;
+        atomic_signal_fence(memory_order_release);
+        monitor->tail = tail;
+
+        PreatResultAppend(&view, TYPE_UINT32, base);
+        PreatResultAppend(&view, TYPE_UINT8, lost);
+        if (length != 0) {
+            PreatResultAppendBytes(&view, data, length);
+        }
+        PreatEncodeNotification(frame, MONITOR_NOTIFY_METHOD, &results);
+    }
+    PreatUnlock(PREAT_LOCK_MONITOR);
+    return result;
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
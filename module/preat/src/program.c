@@ -0,0 +1,252 @@
+/************************************************************************************************
+Copyright (c) 2022-2023, Laboratorio de Microprocesadores
+Facultad de Ciencias Exactas y Tecnología, Universidad Nacional de Tucumán
+https://www.microprocesadores.unt.edu.ar/
+
+Copyright (c) 2022-2023, Esteban Volentini <evolentini@herrera.unt.edu.ar>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** @file
+ ** @brief Stored test programs engine implementation
+ **
+ ** A program is a sequence of method calls stored in a blob, with the same format used in the
+ ** batches. The steps are executed through the methods table, so any method can be used in a
+ ** program, and the control methods declared in this file allow to add delays, loops and branches
+ ** without any intervention of the host.
+ **
+ ** @addtogroup preat PREAT
+ ** @brief Protocol for Remote Excecution of Automated Tests
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "program.h"
+#include "blob.h"
+#include <string.h>
+
+/* === Macros definitions ====================================================================== */
+
+/**
+ * @brief Method used to mark the end of a program before the end of the blob
+ */
+#define PROGRAM_END_METHOD 0x000
+
+/* === Private data type declarations ========================================================== */
+
+/**
+ * @brief Structure with the state of the program in execution
+ */
+typedef struct program_s {
+    bool running;                         /**< Flag to indicate that a program is in execution */
+    void * owner;                         /**< Context that started the program in execution */
+    uint8_t steps;                        /**< Number of steps in the program */
+    uint8_t current;                      /**< Index of the step in execution */
+    uint8_t next;                         /**< Index of the next step to execute */
+    uint32_t value;                       /**< First value returned by the last step executed */
+    uint16_t offsets[PROGRAM_MAX_STEPS];  /**< Position of each step in the program */
+    uint16_t counters[PROGRAM_MAX_STEPS]; /**< Iterations completed by each loop step */
+} * program_t;
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+static preat_error_t ProgramRun(preat_parameters_t parameters, uint8_t count);
+
+static preat_error_t ProgramWait(preat_parameters_t parameters, uint8_t count);
+
+static preat_error_t ProgramLoop(preat_parameters_t parameters, uint8_t count);
+
+static preat_error_t ProgramBranch(preat_parameters_t parameters, uint8_t count);
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/**
+ * @brief Variable with the state of the program in execution
+ */
+static struct program_s program[1] = {0};
+
+PREAT_METHOD(program_run, 0x040, false, ProgramRun, PREAT_PARAMETER(0, TYPE_BLOB));
+
+PREAT_METHOD(program_wait, 0x041, false, ProgramWait, PREAT_PARAMETER(0, TYPE_UINT32));
+
+PREAT_METHOD(program_loop, 0x042, false, ProgramLoop,
+             PREAT_PARAMETER(0, TYPE_UINT8) | PREAT_PARAMETER(1, TYPE_UINT16));
+
+PREAT_METHOD(program_branch, 0x043, false, ProgramBranch,
+             PREAT_PARAMETER(0, TYPE_UINT32) | PREAT_PARAMETER(1, TYPE_UINT8));
+
+/* === Private function implementation ========================================================= */
+
+static uint32_t FirstResult(preat_results_t results) {
+    uint8_t size = 0;
+    uint32_t result = 0;
+
+    if (results->count != 0) {
+        size = PreatTypeSize((preat_type_t)(results->data[0] >> 4));
+    }
+    for (uint8_t position = 0; position < size; position++) {
+        result = (result << 8) | results->data[1 + position];
+    }
+    return result;
+}
+
+static bool ProgramIsRunning(preat_parameters_t parameters) {
+    return program->running && (program->owner == PreatContext(parameters));
+}
+
+static preat_error_t ProgramLoad(const uint8_t * data, const uint8_t * end) {
+    const uint8_t * cursor = data;
+    preat_error_t result = PREAT_NO_ERROR;
+
+    program->steps = 0;
+    while ((result == PREAT_NO_ERROR) && (end - cursor >= 2)) {
+        if ((((uint16_t)cursor[0] << 4) | (cursor[1] >> 4)) == PROGRAM_END_METHOD) {
+            break;
+        }
+        if (program->steps == PROGRAM_MAX_STEPS) {
+            result = PREAT_PARAMETERS_ERROR;
+        } else {
+            program->offsets[program->steps] = (uint16_t)(cursor - data);
+            result = PreatSkipCall(&cursor, end);
+        }
+        if (result == PREAT_NO_ERROR) {
+            program->steps++;
+        }
+    }
+    if ((result == PREAT_NO_ERROR) && (end - cursor == 1)) {
+        result = PREAT_PARAMETERS_ERROR;
+    }
+    memset(program->counters, 0, sizeof(program->counters));
+    return result;
+}
+
+static preat_error_t ProgramRun(preat_parameters_t parameters, uint8_t count) {
+    struct preat_results_s results;
+    const uint8_t * data;
+    const uint8_t * cursor;
+    preat_error_t result;
+    uint32_t size, executed = 0;
+    uint8_t id = (uint8_t)PreatParameterValue(parameters, 0);
+
+    /* The blob is pinned so other server instances can not change it while the program runs */
+    data = BlobPin(id, &size);
+    if (data == NULL) {
+        return PREAT_UNDEFINED_ERROR;
+    }
+
+    /* Programs started from other server instances wait here until this one ends */
+    PreatLock(PREAT_LOCK_PROGRAM);
+    if (program->running) {
+        PreatUnlock(PREAT_LOCK_PROGRAM);
+        BlobUnpin(id);
+        return PREAT_GENERIC_ERROR;
+    }
+
+    result = ProgramLoad(data, data + size);
+    if (result != PREAT_NO_ERROR) {
+        PreatResultFailed(parameters, program->steps);
+        PreatUnlock(PREAT_LOCK_PROGRAM);
+        BlobUnpin(id);
+        return result;
+    }
+
+    program->running = true;
+    program->owner = PreatContext(parameters);
+    program->value = 0;
+    program->current = 0;
+    while ((result == PREAT_NO_ERROR) && (program->current < program->steps)) {
+        if (executed == PROGRAM_MAX_EXECUTED) {
+            result = PREAT_TIMEOUT_ERROR;
+            PreatResultFailed(parameters, program->current);
+            break;
+        }
+        memset(&results, 0, sizeof(results));
+        results.context = PreatContext(parameters);
+        cursor = data + program->offsets[program->current];
+        program->next = program->current + 1;
+        result = PreatExecuteCall(&cursor, data + size, &results);
+        if (result == PREAT_NO_ERROR) {
+            program->value = FirstResult(&results);
+            program->current = program->next;
+            executed++;
+        } else {
+            PreatResultFailed(parameters, program->current);
+        }
+    }
+    program->running = false;
+    PreatUnlock(PREAT_LOCK_PROGRAM);
+    BlobUnpin(id);
+
+    if (result == PREAT_NO_ERROR) {
+        PreatResultAppend(parameters, TYPE_UINT32, executed);
+    }
+    return result;
+}
+
+static preat_error_t ProgramWait(preat_parameters_t parameters, uint8_t count) {
+    ProgramDelay(PreatParameterValue(parameters, 0));
+    return PREAT_NO_ERROR;
+}
+
+static preat_error_t ProgramLoop(preat_parameters_t parameters, uint8_t count) {
+    uint8_t step = (uint8_t)PreatParameterValue(parameters, 0);
+    uint16_t iterations = (uint16_t)PreatParameterValue(parameters, 1);
+
+    if (!ProgramIsRunning(parameters)) {
+        return PREAT_METHOD_ERROR;
+    }
+    if (step >= program->steps) {
+        return PREAT_PARAMETERS_ERROR;
+    }
+
+    if (program->counters[program->current] < iterations) {
+        program->counters[program->current]++;
+        program->next = step;
+    } else {
+        program->counters[program->current] = 0;
+    }
+    return PREAT_NO_ERROR;
+}
+
+static preat_error_t ProgramBranch(preat_parameters_t parameters, uint8_t count) {
+    uint32_t value = PreatParameterValue(parameters, 0);
+    uint8_t step = (uint8_t)PreatParameterValue(parameters, 1);
+
+    if (!ProgramIsRunning(parameters)) {
+        return PREAT_METHOD_ERROR;
+    }
+    if (step > program->steps) {
+        return PREAT_PARAMETERS_ERROR;
+    }
+
+    if (program->value == value) {
+        program->next = step;
+    }
+    return PREAT_NO_ERROR;
+}
+
+/* === Public function implementation ========================================================== */
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
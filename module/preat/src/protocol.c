@@ -35,36 +35,60 @@ SPDX-License-Identifier: MIT
 #include "protocol.h"
 #include "crc.h"
 #include "assertion.h"
+#include <assert.h>
+#include <stdatomic.h>
 #include <string.h>
 
 /* === Macros definitions ====================================================================== */
 
-#define HANDLERS_POOL_SIZE 128
+#ifndef HANDLERS_POOL_SIZE
+#define HANDLERS_POOL_SIZE 8
+#endif
 
-#define ID_NOT_FOUND       0xFFFF
+#define DISPATCH_PAGES_COUNT     16
 
-#define InternalsCount()   sizeof(internals) / sizeof(struct handler_descriptor_s)
+#define DISPATCH_PAGE_SIZE       16
+
+#define ID_NOT_FOUND             0xFFFF
+
+#define STATUS_COMPLETED_METHOD  0x000
+
+#define STATUS_ERROR_METHOD      0x001
+
+#define BATCH_METHOD             0x006
+
+#define MethodPage(id)           (((id) >> 4) & 0xFF)
+
+#define MethodOffset(id)         ((id)&0x0F)
 
 /* === Private data type declarations ========================================================== */
 
 typedef struct preat_message_s {
     uint16_t method;
-    struct preat_parameter_s parameters[16];
     uint8_t param_count;
+    struct preat_parameters_s parameters;
 } * preat_message_t;
 
-typedef struct handler_descriptor_s {
-    bool output : 1;
-    uint16_t id : 15;
-    preat_method_t handler;
-    preat_type_t const * parameters;
-} const * handler_descriptor_t;
-
 typedef struct handlers_pool_s {
     uint16_t next_free;
     struct handler_descriptor_s pool[HANDLERS_POOL_SIZE];
 } * handlers_pool_t;
 
+/**
+ * @brief Direct indexed table to find the descriptor of a method from its 12 bits identifier
+ *
+ * The identifier is splitted in a page number, with the eight most significant bits, and an offset
+ * inside the page, with the four least significant bits. Pages are only assigned to the groups of
+ * methods that have at least one registered method.
+ */
+typedef struct dispatch_table_s {
+    bool initialized;                  /**< Flag to indicate that static methods are indexed */
+    uint8_t conflicts;                 /**< Number of static methods that could not be indexed */
+    uint8_t next_page;                 /**< Number of pages already assigned */
+    uint8_t pages[256];                /**< Page assigned to each group of methods plus one */
+    handler_descriptor_t entries[DISPATCH_PAGES_COUNT][DISPATCH_PAGE_SIZE]; /**< Descriptors */
+} * dispatch_table_t;
+
 typedef struct waiting_assertion_s {
     uint32_t start;
     uint32_t stop;
@@ -75,182 +99,448 @@ typedef struct waiting_assertion_s {
 
 /* === Private variable declarations =========================================================== */
 
+/**
+ * @brief Limits of the section with the methods declared with PREAT_METHOD, provided by linker
+ */
+extern const struct handler_descriptor_s __start_preat_methods[];
+extern const struct handler_descriptor_s __stop_preat_methods[];
+
 /* === Private function declarations =========================================================== */
 
+static preat_error_t LinkWindow(preat_parameters_t parameters, uint8_t count);
+
+static preat_error_t LinkCapacity(preat_parameters_t parameters, uint8_t count);
+
 /* === Public variable definitions ============================================================= */
 
 const preat_type_t SINGLE_UINT8_PARAM[] = {TYPE_UINT8, TYPE_UNDEFINED};
 
-const preat_type_t WAIT_ASSERT_PARAM[] = {TYPE_UINT32, TYPE_UINT32, TYPE_UINT8, TYPE_UINT8,
-                                          TYPE_UNDEFINED};
-
 /* === Private variable definitions ============================================================ */
 
 static struct handlers_pool_s handlers = {0};
 
-static const struct handler_descriptor_s internals[] = {
-    {.id = 0x005, .handler = AssertStart, .parameters = WAIT_ASSERT_PARAM},
-};
+static struct dispatch_table_s dispatch = {0};
+
+PREAT_METHOD(assert_start, 0x005, false, AssertStart,
+             PREAT_PARAMETER(0, TYPE_UINT32) | PREAT_PARAMETER(1, TYPE_UINT32) |
+                 PREAT_PARAMETER(2, TYPE_UINT8) | PREAT_PARAMETER(3, TYPE_UINT8));
+
+PREAT_METHOD(assert_result, 0x009, false, AssertResult, PREAT_SINGLE_UINT8);
+
+PREAT_METHOD(assert_abort, 0x00A, false, AssertAbort, PREAT_SINGLE_UINT8);
+
+PREAT_METHOD(link_window, 0x030, false, LinkWindow, 0);
+
+PREAT_METHOD(link_capacity, 0x031, false, LinkCapacity, 0);
 
 /* === Private function implementation ========================================================= */
 
-static handler_descriptor_t FindDescriptor(uint16_t id) {
-    handler_descriptor_t result = NULL;
-    for (uint16_t index = 0; index < InternalsCount(); index++) {
-        if (internals[index].id == id) {
-            result = &internals[index];
+static uint32_t PackSignature(preat_type_t const * parameters) {
+    uint32_t result = 0;
+    uint8_t index;
+
+    for (index = 0; parameters[index] != TYPE_UNDEFINED; index++) {
+        if (index == PREAT_MAX_PARAMETERS) {
+            result = UINT32_MAX;
             break;
         }
+        result |= PREAT_PARAMETER(index, parameters[index]);
+    }
+    return result;
+}
+
+static bool DispatchInsert(handler_descriptor_t descriptor) {
+    uint8_t page = dispatch.pages[MethodPage(descriptor->id)];
+    bool result = true;
+
+    if (page == 0) {
+        if (dispatch.next_page < DISPATCH_PAGES_COUNT) {
+            dispatch.next_page++;
+            page = dispatch.next_page;
+            dispatch.pages[MethodPage(descriptor->id)] = page;
+        } else {
+            result = false;
+        }
+    }
+    if (result) {
+        handler_descriptor_t * entry = &(dispatch.entries[page - 1][MethodOffset(descriptor->id)]);
+        result = (*entry == NULL);
+        if (result) {
+            *entry = descriptor;
+        }
     }
-    if (result == NULL) {
-        for (uint16_t index = 0; index < handlers.next_free; index++) {
-            if (handlers.pool[index].id == id) {
-                result = &(handlers.pool[index]);
-                break;
+    return result;
+}
+
+static void DispatchInitialize(void) {
+    handler_descriptor_t descriptor;
+
+    if (!dispatch.initialized) {
+        /* Other tasks may find the table not initialized, the flag is checked again locked */
+        PreatLock(PREAT_LOCK_METHODS);
+        if (!dispatch.initialized) {
+            for (descriptor = __start_preat_methods; descriptor < __stop_preat_methods;
+                 descriptor++) {
+                if (!DispatchInsert(descriptor)) {
+                    dispatch.conflicts++;
+                    PreatMethodConflict(descriptor->id);
+                }
             }
+            atomic_thread_fence(memory_order_release);
+            dispatch.initialized = true;
         }
+        PreatUnlock(PREAT_LOCK_METHODS);
+    }
+    atomic_thread_fence(memory_order_acquire);
+}
+
+static handler_descriptor_t FindDescriptor(uint16_t id) {
+    handler_descriptor_t result = NULL;
+    uint8_t page;
+
+    DispatchInitialize();
+    page = dispatch.pages[MethodPage(id)];
+    if (page != 0) {
+        result = dispatch.entries[page - 1][MethodOffset(id)];
     }
     return result;
 }
 
-static preat_error_t DecodeFrame(uint8_t * frame, preat_message_t message) {
-    uint8_t index, type;
-    preat_parameter_t parameter;
+static preat_error_t CheckFrame(uint8_t * frame, bool verified) {
+    uint16_t length = PreatFrameLength(frame);
     crc_t crc;
 
+    if ((length < PREAT_FRAME_MIN_LENGTH + PreatFrameHeader(frame) - 1) ||
+        (length > (PreatFrameIsExtended(frame) ? PREAT_FRAME_EXTENDED_LENGTH
+                                               : PREAT_FRAME_MAX_LENGTH))) {
+        return PREAT_CRC_ERROR;
+    }
+    if (verified) {
+        return PREAT_NO_ERROR;
+    }
+
     crc = crc_init();
-    crc = crc_update(crc, frame, frame[0]);
+    crc = crc_update(crc, frame, length);
     crc = crc_finalize(crc);
 
-    if (crc) {
-        return PREAT_CRC_ERROR;
+    return (crc) ? PREAT_CRC_ERROR : PREAT_NO_ERROR;
+}
+
+static bool ResultsPending(preat_results_t results) {
+    /* The last data type byte has a free nibble when it is not from a sequence of bytes */
+    return (results->length != 0) && ((results->data[results->types] & (TYPE_BINARY | 0x0F)) == 0);
+}
+
+static bool ResultsAppend(preat_results_t results, preat_type_t type, uint32_t value) {
+    uint8_t size = PreatTypeSize(type);
+    bool result = (size != 0) && (results->count < PREAT_MAX_PARAMETERS);
+
+    if (!ResultsPending(results)) {
+        result = result && (results->length + size < sizeof(results->data));
+        if (result) {
+            results->types = results->length;
+            results->data[results->length] = PREAT_TYPE_CODE(type) << 4;
+            results->length++;
+        }
+    } else {
+        result = result && (results->length + size <= sizeof(results->data));
+        if (result) {
+            results->data[results->types] |= PREAT_TYPE_CODE(type);
+        }
+    }
+    if (result) {
+        for (; size > 0; size--) {
+            results->data[results->length] = (uint8_t)(value >> (8 * (size - 1)));
+            results->length++;
+        }
+        results->count++;
+    }
+    return result;
+}
+
+static bool ResultsAppendBytes(preat_results_t results, const uint8_t * data, uint8_t length) {
+    bool result = !ResultsPending(results) && (results->count < PREAT_MAX_PARAMETERS);
+
+    result = result && (length > 0) && (length <= (uint8_t)~TYPE_BINARY);
+    result = result && (results->length + length < sizeof(results->data));
+    if (result) {
+        results->types = results->length;
+        results->data[results->length] = TYPE_BINARY | length;
+        memcpy(&results->data[results->length + 1], data, length);
+        results->length += 1 + length;
+        results->count++;
     }
+    return result;
+}
 
-    message->method = ((uint16_t)frame[1] << 4) | (frame[2] >> 4);
-    memset(message->parameters, 0, sizeof(message->parameters));
+static preat_error_t DecodeCall(const uint8_t ** cursor, const uint8_t * end,
+                                preat_message_t message) {
+    const uint8_t * data = *cursor;
+    uint8_t index, code, size, type = 0;
+    bool pending = false;
 
-    message->param_count = frame[2] & 0x0F;
-    frame = frame + 3;
-    parameter = message->parameters;
+    if (end - data < 2) {
+        return PREAT_PARAMETERS_ERROR;
+    }
 
+    message->method = ((uint16_t)data[0] << 4) | (data[1] >> 4);
+    message->param_count = data[1] & 0x0F;
+    message->parameters.data = data;
+    message->parameters.signature = 0;
+    if (message->param_count > PREAT_MAX_PARAMETERS) {
+        return PREAT_PARAMETERS_ERROR;
+    }
+
+    data = data + 2;
     for (index = 0; index < message->param_count; index++) {
-        if ((index & 0x01) == 0) {
-            type = frame[0];
-            frame = frame + 1;
+        if (!pending) {
+            if (data >= end) {
+                return PREAT_PARAMETERS_ERROR;
+            }
+            type = data[0];
+            data = data + 1;
+            if (type & TYPE_BINARY) {
+                code = PREAT_TYPE_CODE(TYPE_BINARY);
+                size = type & ~TYPE_BINARY;
+            } else {
+                code = type >> 4;
+                size = PreatTypeSize((preat_type_t)code);
+                pending = true;
+            }
         } else {
-            type = type << 4;
+            /* A binary value needs its own type byte, the second nibble only holds fixed types */
+            code = type & 0x0F;
+            size = PreatTypeSize((preat_type_t)code);
+            pending = false;
         }
-        switch (type >> 4) {
-        case 0x01:
-            parameter->type = TYPE_UINT8;
-            parameter->value = frame[0];
-            frame = frame + 1;
-            break;
-        case 0x02:
-            parameter->type = TYPE_UINT16;
-            parameter->value = frame[0];
-            parameter->value <<= 8;
-            parameter->value |= frame[1];
-            frame = frame + 2;
-            break;
-        case 0x03:
-            parameter->type = TYPE_UINT32;
-            parameter->value = frame[0];
-            parameter->value <<= 8;
-            parameter->value |= frame[1];
-            parameter->value <<= 8;
-            parameter->value |= frame[2];
-            parameter->value <<= 8;
-            parameter->value |= frame[3];
-            frame = frame + 4;
-            break;
+        if ((size == 0) || (size > end - data)) {
+            return PREAT_PARAMETERS_ERROR;
         }
-        parameter = parameter + 1;
+        message->parameters.signature |= (uint32_t)code << (4 * index);
+        message->parameters.offsets[index] = (uint16_t)(data - message->parameters.data);
+        message->parameters.lengths[index] = size;
+        data = data + size;
     }
 
+    *cursor = data;
     return PREAT_NO_ERROR;
 }
 
 static bool CompareParameters(preat_message_t message, handler_descriptor_t descriptor) {
-    preat_type_t const * declared = descriptor->parameters;
-    preat_parameter_t received = message->parameters;
-    bool result = (*declared == received->type);
-
-    while ((declared != TYPE_UNDEFINED) && (received->type != TYPE_UNDEFINED)) {
-        result = result && (*declared == received->type);
-        declared++;
-        received++;
+    return (message->parameters.signature == descriptor->signature);
+}
+
+static preat_error_t ExecuteCall(preat_message_t message) {
+    handler_descriptor_t descriptor;
+    preat_error_t result;
+
+    descriptor = FindDescriptor(message->method);
+    if (descriptor == NULL) {
+        result = PREAT_METHOD_ERROR;
+    } else if (!CompareParameters(message, descriptor)) {
+        result = PREAT_PARAMETERS_ERROR;
+    } else if ((descriptor->output) && (AssertIsDefined(message->parameters.results->context))) {
+        result = AssertExecute(descriptor->handler, &message->parameters, message->param_count);
+    } else {
+        result = descriptor->handler(&message->parameters, message->param_count);
     }
     return result;
 }
 
-static void EncodeResponse(uint8_t * frame, preat_error_t result) {
-    static const uint8_t ACK[] = {0x05, 0x00, 0x00, 0xa1, 0xb5};
-    static const uint8_t NACK[] = {0x07, 0x00, 0x11, 0x10, 0x00, 0x00, 0x00};
+static preat_error_t ExecuteBatch(const uint8_t * data, const uint8_t * end,
+                                  preat_results_t results) {
+    preat_error_t result = PREAT_NO_ERROR;
+    uint8_t index = 0;
+
+    while ((result == PREAT_NO_ERROR) && (data < end)) {
+        result = PreatExecuteCall(&data, end, results);
+        if (result == PREAT_NO_ERROR) {
+            index = index + 1;
+        }
+    }
+    if (result != PREAT_NO_ERROR) {
+        results->failed = index + 1;
+    }
+    return result;
+}
+
+static void EncodeResponse(uint8_t * frame, uint16_t method, preat_results_t results) {
+    uint8_t * data = frame + PreatFrameHeader(frame);
+    uint16_t length = (uint16_t)(data - frame) + 2 + results->length;
     crc_t crc;
 
-    if (result == PREAT_NO_ERROR) {
-        memcpy(frame, ACK, sizeof(ACK));
+    if (PreatFrameIsExtended(frame)) {
+        frame[1] = (uint8_t)((length + 2) >> 8);
+        frame[2] = (uint8_t)(length + 2);
     } else {
-        memcpy(frame, NACK, sizeof(NACK));
-        frame[4] = (uint8_t)result;
+        frame[0] = (frame[0] & PREAT_SEQUENCED_FRAME) | (uint8_t)(length + 2);
+    }
+    data[0] = (uint8_t)(method >> 4);
+    data[1] = (uint8_t)(method << 4) | results->count;
 
-        crc = crc_init();
-        crc = crc_update(crc, frame, sizeof(NACK) - 2);
-        crc = crc_finalize(crc);
+    crc = crc_init();
+    crc = crc_update(crc, frame, (uint16_t)(data - frame) + 2);
+    memcpy(&data[2], results->data, results->length);
+    crc = crc_update(crc, results->data, results->length);
+    crc = crc_finalize(crc);
+
+    frame[length] = (uint8_t)(crc >> 8);
+    frame[length + 1] = (uint8_t)(crc & 0xFF);
+}
 
-        frame[5] = (uint8_t)(crc >> 8);
-        frame[6] = (uint8_t)(crc & 0xFF);
+static preat_error_t LinkWindow(preat_parameters_t parameters, uint8_t count) {
+    preat_error_t result = PREAT_GENERIC_ERROR;
+
+    if (PreatResultAppend(parameters, TYPE_UINT8, PREAT_PIPELINE_DEPTH)) {
+        result = PREAT_NO_ERROR;
+    }
+    return result;
+}
+
+static preat_error_t LinkCapacity(preat_parameters_t parameters, uint8_t count) {
+    preat_error_t result = PREAT_GENERIC_ERROR;
+
+    if (PreatResultAppend(parameters, TYPE_UINT16, PREAT_FRAME_EXTENDED_LENGTH)) {
+        result = PREAT_NO_ERROR;
+    }
+    return result;
+}
+
+static void ExecuteFrame(uint8_t * frame, preat_error_t result, void * context) {
+    struct preat_message_s message;
+    struct preat_results_s results = {.context = context};
+    const uint8_t * data = frame + PreatFrameHeader(frame);
+    const uint8_t * end;
+    uint8_t failed;
+
+    if (result == PREAT_NO_ERROR) {
+        end = frame + PreatFrameLength(frame) - 2;
+        if (((((uint16_t)data[0] << 4) | (data[1] >> 4)) == BATCH_METHOD)) {
+            if ((data[1] & 0x0F) != 0) {
+                results.failed = 1;
+                result = PREAT_PARAMETERS_ERROR;
+            } else {
+                result = ExecuteBatch(data + 2, end, &results);
+            }
+        } else {
+            result = DecodeCall(&data, end, &message);
+            if ((result == PREAT_NO_ERROR) && (data != end)) {
+                result = PREAT_PARAMETERS_ERROR;
+            }
+            if (result == PREAT_NO_ERROR) {
+                message.parameters.results = &results;
+                result = ExecuteCall(&message);
+            }
+        }
+    }
+
+    if (result == PREAT_NO_ERROR) {
+        EncodeResponse(frame, STATUS_COMPLETED_METHOD, &results);
+    } else {
+        failed = results.failed;
+        memset(&results, 0, sizeof(results));
+        ResultsAppend(&results, TYPE_UINT8, result);
+        if (failed != 0) {
+            ResultsAppend(&results, TYPE_UINT8, failed - 1);
+        }
+        EncodeResponse(frame, STATUS_ERROR_METHOD, &results);
     }
 }
 
 /* === Public function implementation ========================================================== */
 
+__attribute__((weak)) void PreatMethodConflict(uint16_t id) {
+    (void)id;
+    assert(!"Method declared with PREAT_METHOD could not be indexed");
+}
+
+uint8_t PreatMethodConflicts(void) {
+    DispatchInitialize();
+    return dispatch.conflicts;
+}
+
 bool PreatRegister(uint16_t id, bool output, preat_method_t handler,
                    preat_type_t const * parameters) {
     struct handler_descriptor_s * descriptor = NULL;
 
+    DispatchInitialize();
+    PreatLock(PREAT_LOCK_METHODS);
     if (handlers.next_free < HANDLERS_POOL_SIZE) {
         descriptor = &(handlers.pool[handlers.next_free]);
-        handlers.next_free++;
     }
     if (descriptor) {
         descriptor->id = id;
         descriptor->output = output;
         descriptor->handler = handler;
-        descriptor->parameters = parameters;
+        descriptor->signature = PackSignature(parameters);
+        if (DispatchInsert(descriptor)) {
+            handlers.next_free++;
+        } else {
+            descriptor = NULL;
+        }
     }
 
+    PreatUnlock(PREAT_LOCK_METHODS);
     return (descriptor != NULL);
 }
 
-void PreatExecute(uint8_t * frame) {
-    static struct preat_message_s message;
-    handler_descriptor_t descriptor = NULL;
-    preat_error_t result;
+bool PreatResultAppend(preat_parameters_t parameters, preat_type_t type, uint32_t value) {
+    bool result = false;
 
-    result = DecodeFrame(frame, &message);
-    if (result == PREAT_NO_ERROR) {
-        descriptor = FindDescriptor(message.method);
-        if (descriptor == NULL) {
-            result = PREAT_METHOD_ERROR;
-        }
+    if (parameters->results) {
+        result = ResultsAppend(parameters->results, type, value);
+    }
+    return result;
+}
+
+bool PreatResultAppendBytes(preat_parameters_t parameters, const uint8_t * data, uint8_t length) {
+    bool result = false;
+
+    if (parameters->results) {
+        result = ResultsAppendBytes(parameters->results, data, length);
+    }
+    return result;
+}
+
+void PreatResultFailed(preat_parameters_t parameters, uint8_t position) {
+    if (parameters->results) {
+        parameters->results->failed = position + 1;
     }
+}
+
+preat_error_t PreatSkipCall(const uint8_t ** cursor, const uint8_t * end) {
+    struct preat_message_s message;
 
+    return DecodeCall(cursor, end, &message);
+}
+
+preat_error_t PreatExecuteCall(const uint8_t ** cursor, const uint8_t * end,
+                               preat_results_t results) {
+    struct preat_message_s message;
+    preat_error_t result;
+
+    result = DecodeCall(cursor, end, &message);
     if (result == PREAT_NO_ERROR) {
-        if (CompareParameters(&message, descriptor)) {
-            if ((descriptor->output) && (AssertIsDefined())) {
-                result =
-                    AssertExecute(descriptor->handler, message.parameters, message.param_count);
-            } else {
-                result = descriptor->handler(message.parameters, message.param_count);
-            }
-        } else {
-            result = PREAT_PARAMETERS_ERROR;
-        }
+        message.parameters.results = results;
+        result = ExecuteCall(&message);
     }
+    return result;
+}
+
+void PreatEncodeNotification(uint8_t * frame, uint16_t method, preat_results_t results) {
+    frame[0] = PREAT_FRAME_MIN_LENGTH;
+    EncodeResponse(frame, method, results);
+}
 
-    EncodeResponse(frame, result);
+void PreatExecute(uint8_t * frame) {
+    ExecuteFrame(frame, CheckFrame(frame, false), NULL);
+}
+
+void PreatExecuteChecked(uint8_t * frame, preat_error_t status, void * context) {
+    if (status == PREAT_NO_ERROR) {
+        status = CheckFrame(frame, true);
+    }
+    ExecuteFrame(frame, status, context);
 }
 
 /* === End of documentation ==================================================================== */
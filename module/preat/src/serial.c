@@ -33,119 +33,994 @@ SPDX-License-Identifier: MIT
 /* === Headers files inclusions =============================================================== */
 
 #include "serial.h"
+#include "blob.h"
+#include "crc.h"
 #include "protocol.h"
+#if defined(PREAT_SERIAL_DMA)
+#include "sci_dma.h"
+#endif
+#include <stdatomic.h>
 #include <string.h>
 
 /* === Macros definitions ====================================================================== */
 
+/**
+ * @brief Maximum number of chunks in a bulk transfer
+ */
+#define BULK_MAX_CHUNKS 255
+
+/**
+ * @brief Number of bytes added to the blob data in each chunk, the index and the CRC
+ */
+#define BULK_CHUNK_OVERHEAD 3
+
+/**
+ * @brief Status sent in the ack of a chunk received without errors
+ */
+#define BULK_CHUNK_ACCEPTED 0x00
+
+/**
+ * @brief Status sent in the ack of a chunk received with a CRC error, that must be sent again
+ */
+#define BULK_CHUNK_REJECTED 0x01
+
+/**
+ * @brief Status sent in the ack of a chunk with an invalid index, that ends the bulk transfer
+ */
+#define BULK_TRANSFER_ABORTED 0x02
+
 /* === Private data type declarations ========================================================== */
 
 typedef struct reception_buffer_s {
     uint16_t received;
-    uint8_t data[64];
+    crc_t crc;
+    preat_error_t status;
+    uint8_t data[PREAT_FRAME_EXTENDED_LENGTH];
 } * reception_buffer_t;
 
-typedef struct transmission_buffer_s {
-    uint16_t transmited;
-    uint8_t data[64];
-} * transmission_buffer_t;
+/**
+ * @brief Queue of frames waiting to be sent
+ *
+ * The frames are stored back to back in a ring of bytes. The tasks append frames holding
+ * PREAT_LOCK_TRANSMIT, and the bytes are handed to the transport by whoever gets the draining
+ * flag, the transmit event or the task that queued a frame. The bytes handed to the transport are
+ * released on the next transmit event, when the transport does not use them anymore.
+ */
+typedef struct transmission_queue_s {
+    volatile uint16_t head; /**< Count of bytes queued, written by the tasks */
+    volatile uint16_t next; /**< Count of bytes handed to the transport */
+    volatile uint16_t tail; /**< Count of bytes released, written by the transmit event */
+    atomic_flag draining;   /**< Flag set while the queue is being handed to the transport */
+    volatile bool missed;   /**< Flag set when a drain was skipped because other was running */
+    uint8_t data[PREAT_TRANSMIT_BUFFER_SIZE]; /**< Ring with the frames queued */
+} * transmission_queue_t;
+
+/**
+ * @brief Queue of received frames waiting to be executed
+ *
+ * The queue is a lock-free ring with a single producer and a single consumer. The head index and
+ * the counters are written only by the context that holds the receiving flag, the serial event
+ * handler or the link check that drops a frame stalled by a gap, and the server task is the only
+ * writer of the tail index. When the queue is full the frames are received in the spare buffer and
+ * discarded, so a host that does not respect the pipeline window can not corrupt queued frames.
+ */
+typedef struct reception_queue_s {
+    struct reception_buffer_s slots[PREAT_PIPELINE_DEPTH]; /**< Buffers with the queued frames */
+    struct reception_buffer_s spare[1]; /**< Buffer used to discard frames when queue is full */
+    reception_buffer_t current;         /**< Buffer where the frame in progress is received */
+    volatile uint8_t head;              /**< Count of frames received, written by event handler */
+    volatile uint8_t tail;              /**< Count of frames executed, written by server task */
+    volatile uint32_t received;         /**< Count of frames queued since the server started */
+    volatile uint32_t crc;              /**< Count of frames and chunks with a CRC error */
+    volatile uint32_t overflows;        /**< Count of frames discarded because queue was full */
+    volatile uint32_t framing;          /**< Count of partial frames and headers discarded */
+    uint32_t timestamp;                 /**< Time of the last reception event */
+    bool hunting;                       /**< Flag set while skipping bytes to find a valid header */
+    atomic_flag receiving;              /**< Flag set while a context is receiving */
+    volatile bool missed;               /**< Flag set when an event came while other was receiving */
+} * reception_queue_t;
+
+/**
+ * @brief Blob selected with BLOB.Upload waiting to start its bulk transfer
+ */
+typedef struct bulk_request_s {
+    uint8_t * data; /**< Storage of the blob to load, NULL when there is not a pending request */
+    uint32_t size;  /**< Size in bytes of the blob to load */
+    uint8_t id;     /**< Identifier of the blob to load, pinned until the transfer ends */
+} * bulk_request_t;
+
+/**
+ * @brief State of a bulk transfer that stores the received chunks directly in the blob storage
+ *
+ * Each chunk is formed by the chunk index, the blob data at the offset of the chunk and a CRC of
+ * both fields. The host can send up to PREAT_BULK_WINDOW chunks without waiting for their acks,
+ * and only the chunks rejected by a CRC error must be sent again.
+ */
+typedef struct bulk_transfer_s {
+    uint8_t * volatile data;       /**< Storage of the blob, NULL when the transfer is not active */
+    uint32_t size;                 /**< Size in bytes of the blob */
+    uint8_t id;                    /**< Identifier of the blob, pinned while the transfer runs */
+    uint8_t chunks;                /**< Number of chunks in the transfer */
+    uint8_t pending;               /**< Number of chunks not yet accepted */
+    uint8_t index;                 /**< Index of the chunk in reception */
+    uint8_t crc[2];                /**< CRC of the chunk in reception */
+    crc_t check;                   /**< CRC computed over the bytes of the chunk received */
+    uint16_t length;               /**< Total length of the chunk in reception */
+    uint16_t received;             /**< Number of bytes received of the chunk in reception */
+    uint32_t timestamp;            /**< Time of the last byte received, in milliseconds */
+    uint8_t chunk[PREAT_BULK_CHUNK_SIZE];        /**< Data of the chunk in reception */
+    uint8_t accepted[(BULK_MAX_CHUNKS + 7) / 8]; /**< Bitmap with the chunks already accepted */
+    uint8_t acks[2 * PREAT_BULK_WINDOW];         /**< Ring with the acks waiting to be sent */
+    uint8_t acks_head;                           /**< Count of ack bytes queued */
+    uint8_t acks_tail;                           /**< Count of ack bytes sent */
+} * bulk_transfer_t;
+
+/**
+ * @brief Requests received by the LINK methods waiting for their response to be sent
+ */
+typedef struct link_request_s {
+    uint32_t baud_rate; /**< Baud rate requested with LINK.Baudrate, zero when there is none */
+    bool confirmed;     /**< Flag set when LINK.Confirm was received */
+} * link_request_t;
+
+/**
+ * @brief State of the baud rate negotiation of a server instance
+ */
+typedef struct link_state_s {
+    uint32_t baud_rate; /**< Baud rate currently used by the serial port */
+    uint32_t previous;  /**< Baud rate to roll back to while the current one is not confirmed */
+    uint32_t pending;   /**< Baud rate to apply when the response is sent, zero when there is none */
+    volatile uint32_t drained; /**< Time when the last response was written to the serial port */
+    uint32_t deadline;  /**< Time limit to receive LINK.Confirm */
+    bool confirmed;     /**< Flag set when the current baud rate was confirmed */
+    uint32_t window;    /**< Time when the current error window started */
+    uint32_t errors;    /**< Count of errors when the current error window started */
+} * link_state_t;
+
+/**
+ * @brief State of the DMA transfers used by a serial port
+ */
+typedef struct dma_transfers_s {
+    bool idle;                           /**< Flag set when the last receive event was idle line */
+    volatile bool sending;               /**< Flag set while a transmit transfer is in progress */
+    uint16_t position;                   /**< Offset of the next byte to read in the buffer */
+    uint8_t buffer[PREAT_DMA_BUFFER_SIZE]; /**< Circular buffer of the receive transfer */
+} * dma_transfers_t;
+
+/**
+ * @brief Serial port used as transport by a server instance
+ */
+typedef struct sci_port_s {
+    hal_sci_t sci;                  /**< Serial port descriptor */
+    struct hal_sci_pins_s pins;     /**< Pins used by the serial port, to configure it again */
+    preat_server_t volatile server; /**< Server instance that uses the serial port */
+#if defined(PREAT_SERIAL_DMA)
+    struct dma_transfers_s dma[1]; /**< State of the DMA transfers */
+#endif
+} * sci_port_t;
 
 struct preat_server_s {
-    hal_sci_t sci;
-    preat_event_t handler;
+    preat_transport_t volatile transport;
+    void * port;
+    preat_event_t volatile handler;
     void * object;
-    struct reception_buffer_s rxd[1];
-    struct transmission_buffer_s txd[1];
+    struct reception_queue_s rxd[1];
+    struct transmission_queue_s txd[1];
+    struct bulk_request_s upload[1];
+    struct bulk_transfer_s bulk[1];
+    struct link_request_s request[1];
+    struct link_state_s link[1];
 };
 
 /* === Private variable declarations =========================================================== */
 
 /* === Private function declarations =========================================================== */
 
+static preat_error_t BulkUpload(preat_parameters_t parameters, uint8_t count);
+
+static preat_error_t LinkCounters(preat_parameters_t parameters, uint8_t count);
+
+static preat_error_t LinkBaudrate(preat_parameters_t parameters, uint8_t count);
+
+static preat_error_t LinkConfirm(preat_parameters_t parameters, uint8_t count);
+
+static uint16_t SciReceive(void * port, uint8_t * data, uint16_t size);
+
+static uint16_t SciSend(void * port, const uint8_t * data, uint16_t size);
+
+static bool SciConfigure(void * port, uint32_t baud_rate);
+
+#if defined(PREAT_SERIAL_DMA)
+static uint16_t DmaReceive(void * port, uint8_t * data, uint16_t size);
+
+static uint16_t DmaSend(void * port, const uint8_t * data, uint16_t size);
+#endif
+
 /* === Public variable definitions ============================================================= */
 
 /* === Private variable definitions ============================================================ */
 
-static struct preat_server_s server_instances[1];
+static struct preat_server_s server_instances[PREAT_SERVER_INSTANCES];
+
+static struct sci_port_s sci_ports[PREAT_SERVER_INSTANCES];
+
+static const struct preat_transport_s sci_transport = {
+    .receive = SciReceive,
+    .send = SciSend,
+    .configure = SciConfigure,
+};
+
+#if defined(PREAT_SERIAL_DMA)
+static const struct preat_transport_s dma_transport = {
+    .receive = DmaReceive,
+    .send = DmaSend,
+    .configure = SciConfigure,
+};
+#endif
+
+PREAT_METHOD(blob_upload, 0x008, false, BulkUpload, PREAT_SINGLE_UINT8);
+
+PREAT_METHOD(link_counters, 0x032, false, LinkCounters, 0);
+
+PREAT_METHOD(link_baudrate, 0x033, false, LinkBaudrate, PREAT_PARAMETER(0, TYPE_UINT32));
+
+PREAT_METHOD(link_confirm, 0x034, false, LinkConfirm, 0);
 
 /* === Private function implementation ========================================================= */
 
-static void SerialEvent(hal_sci_t sci, sci_status_t status, void * object) {
-    preat_server_t server = object;
-    uint16_t length;
+static uint16_t ReceiveData(preat_server_t server, uint8_t * data, uint16_t size) {
+    uint16_t result = server->transport->receive(server->port, data, size);
+
+    if (result != 0) {
+        server->rxd->timestamp = ServerTimestamp();
+    }
+    return result;
+}
+
+static uint16_t SendData(preat_server_t server, const uint8_t * data, uint16_t size) {
+    return server->transport->send(server->port, data, size);
+}
+
+static reception_buffer_t NextReceptionBuffer(reception_queue_t queue) {
+    reception_buffer_t result = queue->spare;
+
+    if ((uint8_t)(queue->head - queue->tail) < PREAT_PIPELINE_DEPTH) {
+        result = &(queue->slots[queue->head % PREAT_PIPELINE_DEPTH]);
+    }
+    result->received = 0;
+    result->crc = crc_init();
+    return result;
+}
+
+static uint16_t FrameLengthSize(reception_buffer_t buffer) {
+    return PreatFrameIsExtended(buffer->data) ? 3 : 1;
+}
+
+static bool FrameHeaderValid(reception_buffer_t buffer) {
+    uint16_t length = PreatFrameLength(buffer->data);
+    uint16_t maximum = PreatFrameIsExtended(buffer->data) ? sizeof(buffer->data)
+                                                          : PREAT_FRAME_MAX_LENGTH;
+
+    return (length >= PREAT_FRAME_MIN_LENGTH + PreatFrameHeader(buffer->data) - 1) &&
+           (length <= maximum);
+}
+
+static void FrameSkipByte(reception_queue_t queue, reception_buffer_t buffer) {
+    if (!queue->hunting) {
+        queue->hunting = true;
+        queue->framing++;
+    }
+    buffer->received--;
+    memmove(buffer->data, buffer->data + 1, buffer->received);
+    buffer->crc = crc_update(crc_init(), buffer->data, buffer->received);
+}
+
+static void FrameCompleted(preat_server_t server, preat_error_t status) {
+    reception_queue_t queue = server->rxd;
+    reception_buffer_t buffer = queue->current;
+
+    buffer->status = status;
+    if (status == PREAT_CRC_ERROR) {
+        queue->crc++;
+    }
+    if (buffer == queue->spare) {
+        queue->overflows++;
+    } else {
+        atomic_signal_fence(memory_order_release);
+        queue->head++;
+        queue->received++;
+        if (server->handler) {
+            server->handler(server, server->object);
+        }
+    }
+    queue->current = NextReceptionBuffer(queue);
+}
+
+static void FrameDropped(preat_server_t server) {
+    reception_buffer_t buffer = server->rxd->current;
+
+    server->rxd->framing++;
+    server->rxd->hunting = false;
+    if (buffer->received < PreatFrameHeader(buffer->data)) {
+        buffer->data[0] = PREAT_FRAME_MIN_LENGTH;
+        buffer->received = 1;
+    }
+    FrameCompleted(server, PREAT_FRAMING_ERROR);
+}
+
+static uint16_t FrameMissingBytes(reception_buffer_t buffer) {
+    uint16_t result = 1;
+
+    if (buffer->received != 0) {
+        if (buffer->received < FrameLengthSize(buffer)) {
+            result = FrameLengthSize(buffer) - buffer->received;
+        } else {
+            result = PreatFrameLength(buffer->data) - buffer->received;
+        }
+    }
+    return result;
+}
+
+static void SerialReceive(preat_server_t server) {
+    reception_queue_t queue = server->rxd;
+    reception_buffer_t buffer;
+    uint16_t length, received;
+
+    do {
+        if ((queue->current == queue->spare) && (queue->spare->received == 0)) {
+            queue->current = NextReceptionBuffer(queue);
+        }
+        buffer = queue->current;
+        length = FrameMissingBytes(buffer);
+        received = ReceiveData(server, buffer->data + buffer->received, length);
+        buffer->crc = crc_update(buffer->crc, buffer->data + buffer->received, received);
+        buffer->received += received;
+
+        while ((buffer->received >= FrameLengthSize(buffer)) && !FrameHeaderValid(buffer)) {
+            FrameSkipByte(queue, buffer);
+        }
+        if ((received != 0) && (buffer->received > FrameLengthSize(buffer)) &&
+            (buffer->received == PreatFrameLength(buffer->data))) {
+            queue->hunting = false;
+            FrameCompleted(server, crc_finalize(buffer->crc) ? PREAT_CRC_ERROR : PREAT_NO_ERROR);
+        }
+    } while (received != 0);
+}
+
+static preat_error_t BulkUpload(preat_parameters_t parameters, uint8_t count) {
+    preat_server_t server = PreatContext(parameters);
+    uint8_t id = (uint8_t)PreatParameterValue(parameters, 0);
+    uint32_t size;
     uint8_t * data;
 
-    if (status->data_ready) {
-        data = server->rxd->data + server->rxd->received;
-        if (server->rxd->received == 0) {
-            length = sizeof(server->rxd->data);
+    if (server == NULL) {
+        return PREAT_GENERIC_ERROR;
+    }
+    data = BlobPin(id, &size);
+    if (data == NULL) {
+        return PREAT_UNDEFINED_ERROR;
+    }
+    if ((size + PREAT_BULK_CHUNK_SIZE - 1) / PREAT_BULK_CHUNK_SIZE > BULK_MAX_CHUNKS) {
+        BlobUnpin(id);
+        return PREAT_PARAMETERS_ERROR;
+    }
+
+    /* A previous request whose response could not be sent is replaced by this one */
+    if (server->upload->data != NULL) {
+        BlobUnpin(server->upload->id);
+    }
+    server->upload->id = id;
+    server->upload->size = size;
+    server->upload->data = data;
+    PreatResultAppend(parameters, TYPE_UINT8,
+                      (size + PREAT_BULK_CHUNK_SIZE - 1) / PREAT_BULK_CHUNK_SIZE);
+    PreatResultAppend(parameters, TYPE_UINT16, PREAT_BULK_CHUNK_SIZE);
+    PreatResultAppend(parameters, TYPE_UINT8, PREAT_BULK_WINDOW);
+    return PREAT_NO_ERROR;
+}
+
+static void BulkStart(bulk_transfer_t bulk, bulk_request_t request) {
+    bulk->id = request->id;
+    bulk->size = request->size;
+    bulk->chunks = (request->size + PREAT_BULK_CHUNK_SIZE - 1) / PREAT_BULK_CHUNK_SIZE;
+    bulk->pending = bulk->chunks;
+    bulk->received = 0;
+    bulk->timestamp = ServerTimestamp();
+    memset(bulk->accepted, 0, sizeof(bulk->accepted));
+    bulk->data = request->data;
+    request->data = NULL;
+}
+
+static void BulkFinish(bulk_transfer_t bulk) {
+    bulk->received = 0;
+    bulk->data = NULL;
+    BlobUnpin(bulk->id);
+}
+
+static bool BulkTransmitAck(preat_server_t server) {
+    bulk_transfer_t bulk = server->bulk;
+    uint8_t position = bulk->acks_tail % sizeof(bulk->acks);
+    uint8_t length = 2 - (bulk->acks_tail % 2);
+    uint16_t sent;
+
+    /* Both bytes of the ack are handed at once, or the rest of one the transport took in part */
+    sent = SendData(server, &bulk->acks[position], length);
+    bulk->acks_tail += sent;
+    return (sent == length);
+}
+
+static void BulkTransmit(preat_server_t server) {
+    bulk_transfer_t bulk = server->bulk;
+
+    while ((bulk->acks_head != bulk->acks_tail) && BulkTransmitAck(server)) {
+    }
+}
+
+static bool TransmitEnqueue(transmission_queue_t queue, const uint8_t * frame, uint16_t length) {
+    uint16_t position = queue->head % sizeof(queue->data);
+    uint16_t contiguous = sizeof(queue->data) - position;
+
+    if ((uint16_t)(sizeof(queue->data) - (uint16_t)(queue->head - queue->tail)) < length) {
+        return false;
+    }
+    if (contiguous >= length) {
+        memcpy(&queue->data[position], frame, length);
+    } else {
+        memcpy(&queue->data[position], frame, contiguous);
+        memcpy(queue->data, frame + contiguous, length - contiguous);
+    }
+    atomic_thread_fence(memory_order_release);
+    queue->head += length;
+    return true;
+}
+
+static void TransmitDrain(preat_server_t server) {
+    transmission_queue_t queue = server->txd;
+    uint16_t position, length, sent;
+
+    /* Only one context hands bytes to the transport, the others leave a mark to be repeated */
+    do {
+        if (atomic_flag_test_and_set(&queue->draining)) {
+            queue->missed = true;
+            return;
+        }
+        queue->missed = false;
+        atomic_thread_fence(memory_order_acquire);
+        /* No frame is sent between the two bytes of an ack that the transport took in part */
+        if ((server->bulk->acks_tail % 2 == 0) || BulkTransmitAck(server)) {
+            while (queue->next != queue->head) {
+                position = queue->next % sizeof(queue->data);
+                length = (uint16_t)(queue->head - queue->next);
+                if (length > sizeof(queue->data) - position) {
+                    length = sizeof(queue->data) - position;
+                }
+                sent = SendData(server, &queue->data[position], length);
+                if (sent == 0) {
+                    break;
+                }
+                queue->next += sent;
+            }
+            if (queue->next == queue->head) {
+                BulkTransmit(server);
+            }
+        }
+        atomic_flag_clear(&queue->draining);
+    } while (queue->missed);
+}
+
+static void BulkAcknowledge(preat_server_t server, uint8_t index, uint8_t status) {
+    bulk_transfer_t bulk = server->bulk;
+
+    if ((uint8_t)(bulk->acks_head - bulk->acks_tail) <= sizeof(bulk->acks) - 2) {
+        bulk->acks[bulk->acks_head++ % sizeof(bulk->acks)] = index;
+        bulk->acks[bulk->acks_head++ % sizeof(bulk->acks)] = status;
+    }
+    TransmitDrain(server);
+}
+
+static void BulkChunkReceived(preat_server_t server) {
+    bulk_transfer_t bulk = server->bulk;
+    uint8_t mask = 1 << (bulk->index % 8);
+
+    if (crc_finalize(bulk->check) != 0) {
+        server->rxd->crc++;
+        BulkAcknowledge(server, bulk->index, BULK_CHUNK_REJECTED);
+    } else {
+        /* A chunk sent again because its ack was lost is not written over the accepted one */
+        if ((bulk->accepted[bulk->index / 8] & mask) == 0) {
+            memcpy(bulk->data + bulk->index * PREAT_BULK_CHUNK_SIZE, bulk->chunk,
+                   bulk->length - BULK_CHUNK_OVERHEAD);
+            bulk->accepted[bulk->index / 8] |= mask;
+            bulk->pending--;
+        }
+        BulkAcknowledge(server, bulk->index, BULK_CHUNK_ACCEPTED);
+        if (bulk->pending == 0) {
+            BulkFinish(bulk);
+        }
+    }
+}
+
+static void BulkReceive(preat_server_t server) {
+    bulk_transfer_t bulk = server->bulk;
+    uint16_t data_length, length, received;
+    uint8_t * target;
+
+    do {
+        data_length = bulk->length - BULK_CHUNK_OVERHEAD;
+        if (bulk->received == 0) {
+            bulk->check = crc_init();
+            target = &bulk->index;
+            length = 1;
+        } else if (bulk->received <= data_length) {
+            target = bulk->chunk + bulk->received - 1;
+            length = data_length + 1 - bulk->received;
         } else {
-            length = server->rxd->data[0] - server->rxd->received;
+            target = bulk->crc + bulk->received - data_length - 1;
+            length = bulk->length - bulk->received;
+        }
+        received = ReceiveData(server, target, length);
+        bulk->check = crc_update(bulk->check, target, received);
+        bulk->received += received;
+        if (received != 0) {
+            bulk->timestamp = server->rxd->timestamp;
         }
-        server->rxd->received += SciReceiveData(sci, data, length);
-        if (server->rxd->data[0] == server->rxd->received) {
-            if (server->handler) {
-                server->handler(server, server->object);
+
+        if ((received != 0) && (bulk->received == 1)) {
+            if (bulk->index >= bulk->chunks) {
+                BulkAcknowledge(server, bulk->index, BULK_TRANSFER_ABORTED);
+                BulkFinish(bulk);
+            } else if (bulk->index == bulk->chunks - 1) {
+                bulk->length = bulk->size - bulk->index * PREAT_BULK_CHUNK_SIZE;
+                bulk->length += BULK_CHUNK_OVERHEAD;
+            } else {
+                bulk->length = PREAT_BULK_CHUNK_SIZE + BULK_CHUNK_OVERHEAD;
             }
+        } else if ((received != 0) && (bulk->received == bulk->length)) {
+            BulkChunkReceived(server);
+            bulk->received = 0;
         }
+    } while ((received != 0) && (bulk->data != NULL));
+
+    if (bulk->data == NULL) {
+        bulk->received = 0;
+        SerialReceive(server);
+    }
+}
+
+static preat_error_t LinkCounters(preat_parameters_t parameters, uint8_t count) {
+    preat_server_t server = PreatContext(parameters);
+    struct preat_server_counters_s counters;
+    preat_error_t result = PREAT_GENERIC_ERROR;
+
+    if (server == NULL) {
+        return result;
+    }
+    ServerGetCounters(server, &counters);
+    if (PreatResultAppend(parameters, TYPE_UINT32, counters.received) &&
+        PreatResultAppend(parameters, TYPE_UINT32, counters.crc) &&
+        PreatResultAppend(parameters, TYPE_UINT32, counters.overflows) &&
+        PreatResultAppend(parameters, TYPE_UINT32, counters.framing)) {
+        result = PREAT_NO_ERROR;
+    }
+    return result;
+}
+
+static preat_error_t LinkBaudrate(preat_parameters_t parameters, uint8_t count) {
+    preat_server_t server = PreatContext(parameters);
+    uint32_t baud_rate = PreatParameterValue(parameters, 0);
+
+    if (server == NULL) {
+        return PREAT_GENERIC_ERROR;
     }
-    if ((status->fifo_empty) & (server->txd->data[0] != 0)) {
-        data = server->txd->data + server->txd->transmited;
-        length = server->txd->data[0] - server->txd->transmited;
-        server->txd->transmited += SciSendData(sci, data, length);
-        if (server->txd->data[0] == server->txd->transmited) {
-            server->txd->data[0] = 0;
-            server->txd->transmited = 0;
+    if ((baud_rate == 0) || (baud_rate > PREAT_BAUD_RATE_MAX)) {
+        return PREAT_PARAMETERS_ERROR;
+    }
+    server->request->baud_rate = baud_rate;
+    return PREAT_NO_ERROR;
+}
+
+static preat_error_t LinkConfirm(preat_parameters_t parameters, uint8_t count) {
+    preat_server_t server = PreatContext(parameters);
+
+    if (server == NULL) {
+        return PREAT_GENERIC_ERROR;
+    }
+    server->request->confirmed = true;
+    return PREAT_NO_ERROR;
+}
+
+static bool LinkSetBaudRate(preat_server_t server, uint32_t baud_rate) {
+    bool result = true;
+
+    if (server->transport->configure) {
+        result = server->transport->configure(server->port, baud_rate);
+    }
+    if (result) {
+        server->link->baud_rate = baud_rate;
+    }
+    return result;
+}
+
+static void SerialExpired(preat_server_t server) {
+    if ((server->bulk->data != NULL) && (server->bulk->received != 0)) {
+        server->bulk->received = 0;
+        server->rxd->framing++;
+    } else if ((server->bulk->data == NULL) && (server->rxd->current->received != 0)) {
+        FrameDropped(server);
+    }
+}
+
+static void SerialTimeout(preat_server_t server, bool continued) {
+    uint32_t now = ServerTimestamp();
+
+    if (!continued && ((uint32_t)(now - server->rxd->timestamp) > PREAT_INTERBYTE_TIMEOUT)) {
+        SerialExpired(server);
+    }
+    server->rxd->timestamp = now;
+}
+
+static void SerialRead(preat_server_t server) {
+    if (server->bulk->data != NULL) {
+        BulkReceive(server);
+    } else {
+        SerialReceive(server);
+    }
+}
+
+static bool ServerRunning(preat_server_t server) {
+    bool result = (server != NULL) && (server->transport != NULL);
+
+    atomic_signal_fence(memory_order_acquire);
+    return result;
+}
+
+static bool ReceptionTake(reception_queue_t queue) {
+    bool result = !atomic_flag_test_and_set(&queue->receiving);
+
+    if (!result) {
+        queue->missed = true;
+    }
+    return result;
+}
+
+static void ReceptionRelease(preat_server_t server) {
+    reception_queue_t queue = server->rxd;
+
+    /* The bytes of an event skipped while this context was receiving are read before leaving */
+    atomic_flag_clear(&queue->receiving);
+    while (queue->missed && ReceptionTake(queue)) {
+        queue->missed = false;
+        SerialTimeout(server, true);
+        SerialRead(server);
+        atomic_flag_clear(&queue->receiving);
+    }
+}
+
+static void ReceptionCheck(preat_server_t server) {
+    bulk_transfer_t bulk = server->bulk;
+    uint32_t now;
+
+    /* A frame stalled by a gap is dropped here, without waiting for the next byte to arrive */
+    if (ReceptionTake(server->rxd)) {
+        SerialRead(server);
+        now = ServerTimestamp();
+        if ((uint32_t)(now - server->rxd->timestamp) > PREAT_INTERBYTE_TIMEOUT) {
+            SerialExpired(server);
+        }
+        /* A bulk transfer abandoned by the host is aborted to receive frames again */
+        if ((bulk->data != NULL) && ((uint32_t)(now - bulk->timestamp) >= PREAT_BULK_TIMEOUT)) {
+            BulkFinish(bulk);
         }
+        ReceptionRelease(server);
     }
 }
 
-/* === Public function implementation ========================================================== */
+static uint16_t SciReceive(void * port, uint8_t * data, uint16_t size) {
+    return SciReceiveData(((sci_port_t)port)->sci, data, size);
+}
 
-preat_server_t ServerStartSerial(hal_sci_t sci, hal_sci_pins_t serial_pins) {
-    static const struct hal_sci_line_s port_config = {
-        .baud_rate = 115200,
+static uint16_t SciSend(void * port, const uint8_t * data, uint16_t size) {
+    return SciSendData(((sci_port_t)port)->sci, data, size);
+}
+
+static bool SciConfigure(void * port, uint32_t baud_rate) {
+    sci_port_t sci_port = port;
+    struct hal_sci_line_s line = {
+        .baud_rate = baud_rate,
         .data_bits = 8,
         .parity = HAL_SCI_NO_PARITY,
     };
+
+    return SciSetConfig(sci_port->sci, &line, &sci_port->pins);
+}
+
+static void SerialEvent(hal_sci_t sci, sci_status_t status, void * object) {
+    sci_port_t port = object;
+
+    if (status->data_ready) {
+        ServerReceiveEvent(port->server, false);
+    }
+    if (status->fifo_empty) {
+        ServerTransmitEvent(port->server);
+    }
+}
+
+static sci_port_t SciPortCreate(hal_sci_t sci, hal_sci_pins_t serial_pins) {
+    sci_port_t port = NULL;
+
+    /* A serial port already in use is started again, otherwise the first free one is taken */
+    for (uint8_t index = 0; index < PREAT_SERVER_INSTANCES; index++) {
+        if ((sci_ports[index].server != NULL) && (sci_ports[index].sci == sci)) {
+            port = &sci_ports[index];
+            break;
+        } else if ((port == NULL) && (sci_ports[index].server == NULL)) {
+            port = &sci_ports[index];
+        }
+    }
+    if (port == NULL) {
+        return NULL;
+    }
+    /* The events of the port are ignored until a server instance is attached to it again */
+    port->server = NULL;
+    atomic_signal_fence(memory_order_seq_cst);
+    memset(port, 0, sizeof(struct sci_port_s));
+    port->sci = sci;
+    port->pins = *serial_pins;
+    return port;
+}
+
+#if defined(PREAT_SERIAL_DMA)
+static uint16_t DmaReceive(void * port, uint8_t * data, uint16_t size) {
+    sci_port_t sci_port = port;
+    dma_transfers_t dma = sci_port->dma;
+    uint16_t position = SciDmaReceivePosition(sci_port->sci);
+    uint16_t result = 0;
+
+    while ((dma->position != position) && (result < size)) {
+        data[result++] = dma->buffer[dma->position];
+        dma->position = (dma->position + 1) % sizeof(dma->buffer);
+    }
+    return result;
+}
+
+static uint16_t DmaSend(void * port, const uint8_t * data, uint16_t size) {
+    sci_port_t sci_port = port;
+    dma_transfers_t dma = sci_port->dma;
+
+    if ((size == 0) || dma->sending) {
+        return 0;
+    }
+    dma->sending = true;
+    if (!SciDmaSend(sci_port->sci, data, size)) {
+        dma->sending = false;
+        return 0;
+    }
+    return size;
+}
+
+static void SerialDmaEvent(hal_sci_t sci, sci_dma_event_t event, void * object) {
+    sci_port_t port = object;
+
+    if (event == SCI_DMA_TRANSMIT_DONE) {
+        port->dma->sending = false;
+        ServerTransmitEvent(port->server);
+    } else {
+        /* After a half buffer event the bytes are contiguous, the line has not been idle */
+        ServerReceiveEvent(port->server, !port->dma->idle);
+        port->dma->idle = (event == SCI_DMA_RECEIVE_IDLE);
+    }
+}
+#endif
+
+/* === Public function implementation ========================================================== */
+
+preat_server_t ServerStart(preat_transport_t transport, void * port) {
     preat_server_t server = NULL;
 
-    if (SciSetConfig(sci, &port_config, serial_pins)) {
-        server = server_instances;
+    /* A port already in use is served again by its instance, otherwise a free one is taken */
+    for (uint8_t index = 0; index < PREAT_SERVER_INSTANCES; index++) {
+        if ((server_instances[index].transport != NULL) && (server_instances[index].port == port)) {
+            server = &server_instances[index];
+            break;
+        } else if ((server == NULL) && (server_instances[index].transport == NULL)) {
+            server = &server_instances[index];
+        }
+    }
+    if (server == NULL) {
+        return NULL;
+    }
 
-        memset(server, 0, sizeof(struct preat_server_s));
-        server->sci = sci;
-        SciSetEventHandler(sci, SerialEvent, server);
+    /* The events of a running instance are ignored until it is initialized again */
+    server->transport = NULL;
+    atomic_signal_fence(memory_order_seq_cst);
+    if (server->upload->data != NULL) {
+        BlobUnpin(server->upload->id);
+    }
+    if (server->bulk->data != NULL) {
+        BlobUnpin(server->bulk->id);
+    }
+    memset(server, 0, sizeof(struct preat_server_s));
+    server->port = port;
+    server->link->confirmed = true;
+    server->rxd->current = NextReceptionBuffer(server->rxd);
+    if ((transport->configure != NULL) && !transport->configure(port, PREAT_BAUD_RATE)) {
+        return NULL;
     }
+    server->link->baud_rate = PREAT_BAUD_RATE;
+    atomic_signal_fence(memory_order_release);
+    server->transport = transport;
     return server;
 }
 
+void ServerReceiveEvent(preat_server_t server, bool continued) {
+    if (ServerRunning(server) && ReceptionTake(server->rxd)) {
+        SerialTimeout(server, continued);
+        SerialRead(server);
+        ReceptionRelease(server);
+    }
+}
+
+void ServerTransmitEvent(preat_server_t server) {
+    transmission_queue_t queue;
+
+    if (!ServerRunning(server)) {
+        return;
+    }
+    queue = server->txd;
+    /* The transport has finished with all the bytes handed to it before this event */
+    if (queue->tail != queue->next) {
+        queue->tail = queue->next;
+        if (queue->tail == queue->head) {
+            server->link->drained = ServerTimestamp();
+        }
+    }
+    TransmitDrain(server);
+}
+
+preat_server_t ServerStartSerial(hal_sci_t sci, hal_sci_pins_t serial_pins) {
+    sci_port_t port = SciPortCreate(sci, serial_pins);
+
+    if (port == NULL) {
+        return NULL;
+    }
+    port->server = ServerStart(&sci_transport, port);
+    if (port->server) {
+        SciSetEventHandler(sci, SerialEvent, port);
+    }
+    return port->server;
+}
+
+#if defined(PREAT_SERIAL_DMA)
+preat_server_t ServerStartSerialDma(hal_sci_t sci, hal_sci_pins_t serial_pins) {
+    sci_port_t port = SciPortCreate(sci, serial_pins);
+
+    if (port == NULL) {
+        return NULL;
+    }
+    port->dma->idle = true;
+    port->server = ServerStart(&dma_transport, port);
+    if (port->server) {
+        if (!SciDmaStart(sci, port->dma->buffer, sizeof(port->dma->buffer), SerialDmaEvent,
+                         port)) {
+            port->server = NULL;
+        }
+    }
+    return port->server;
+}
+#endif
+
 void ServerSetEventHandler(preat_server_t server, preat_event_t handler, void * object) {
     if (server) {
-        server->handler = handler;
+        /* The object is stored first, an interrupt may call the handler as soon as it is set */
         server->object = object;
+        atomic_signal_fence(memory_order_release);
+        server->handler = handler;
+    }
+}
+
+void ServerSignalEvent(preat_server_t server) {
+    if (ServerRunning(server) && server->handler) {
+        server->handler(server, server->object);
     }
 }
 
-bool ServerReceiveCommand(preat_server_t server, uint8_t * command) {
-    bool result = (server->rxd->received != 0);
-    result &= (server->rxd->data[0] == server->rxd->received);
+bool ServerReceiveCommand(preat_server_t server, uint8_t * command, preat_error_t * status) {
+    reception_queue_t queue = server->rxd;
+    reception_buffer_t buffer;
+    bool result = (queue->head != queue->tail);
 
     if (result) {
-        memcpy(command, server->rxd->data, server->rxd->received);
-        server->rxd->received = 0;
+        atomic_signal_fence(memory_order_acquire);
+        buffer = &(queue->slots[queue->tail % PREAT_PIPELINE_DEPTH]);
+        memcpy(command, buffer->data, buffer->received);
+        if (status) {
+            *status = buffer->status;
+        }
+        atomic_signal_fence(memory_order_release);
+        queue->tail++;
     }
     return result;
 }
 
+void ServerGetCounters(preat_server_t server, preat_server_counters_t counters) {
+    counters->received = server->rxd->received;
+    counters->crc = server->rxd->crc;
+    counters->overflows = server->rxd->overflows;
+    counters->framing = server->rxd->framing;
+}
+
+void ServerCheckLink(preat_server_t server) {
+    link_state_t link = server->link;
+    uint32_t now = ServerTimestamp();
+    uint32_t errors = server->rxd->crc + server->rxd->framing;
+    uint32_t baud_rate = link->baud_rate;
+
+    ReceptionCheck(server);
+
+    if ((link->pending != 0) && (server->txd->tail == server->txd->head) &&
+        ((uint32_t)(now - link->drained) >= PREAT_LINK_CHECK_PERIOD)) {
+        if (link->confirmed) {
+            link->previous = link->baud_rate;
+        }
+        if (LinkSetBaudRate(server, link->pending)) {
+            link->confirmed = false;
+            link->deadline = now + PREAT_BAUD_CONFIRM_TIMEOUT;
+        }
+        link->pending = 0;
+    } else if (!link->confirmed && ((int32_t)(now - link->deadline) >= 0)) {
+        LinkSetBaudRate(server, link->previous);
+        link->confirmed = true;
+    } else if ((link->baud_rate != PREAT_BAUD_RATE) &&
+               (errors - link->errors >= PREAT_LINK_MAX_ERRORS)) {
+        LinkSetBaudRate(server, PREAT_BAUD_RATE);
+        link->confirmed = true;
+    }
+
+    if ((link->baud_rate != baud_rate) ||
+        ((uint32_t)(now - link->window) >= PREAT_LINK_ERROR_WINDOW)) {
+        link->window = now;
+        link->errors = errors;
+    }
+}
+
 bool ServerTransmitResponse(preat_server_t server, uint8_t * response) {
-    bool result = (server->txd->data[0] == 0);
-    transmission_buffer_t buffer = server->txd;
+    bool result;
 
+    PreatLock(PREAT_LOCK_TRANSMIT);
+    result = TransmitEnqueue(server->txd, response, PreatFrameLength(response));
     if (result) {
-        memcpy(buffer->data, response, response[0]);
-        buffer->transmited += SciSendData(server->sci, buffer->data, buffer->data[0]);
+        if (server->upload->data != NULL) {
+            BulkStart(server->bulk, server->upload);
+        }
+        if (server->request->baud_rate != 0) {
+            server->link->pending = server->request->baud_rate;
+            server->request->baud_rate = 0;
+        }
+        if (server->request->confirmed) {
+            server->link->confirmed = true;
+            server->request->confirmed = false;
+        }
     }
+    PreatUnlock(PREAT_LOCK_TRANSMIT);
+    TransmitDrain(server);
+    return result;
+}
+
+bool ServerTransmitHeld(preat_server_t server) {
+    bulk_transfer_t bulk = server->bulk;
+
+    return (bulk->data != NULL) || (bulk->acks_head != bulk->acks_tail);
+}
+
+bool ServerTransmitFrame(preat_server_t server, const uint8_t * frame) {
+    bool result;
+
+    PreatLock(PREAT_LOCK_TRANSMIT);
+    /* The acks of a bulk transfer are not framed, the host could not tell a frame between them */
+    result = !ServerTransmitHeld(server) &&
+             TransmitEnqueue(server->txd, frame, PreatFrameLength(frame));
+    PreatUnlock(PREAT_LOCK_TRANSMIT);
+    TransmitDrain(server);
     return result;
 }
 
@@ -0,0 +1,119 @@
+/************************************************************************************************
+Copyright (c) 2022-2023, Laboratorio de Microprocesadores
+Facultad de Ciencias Exactas y Tecnología, Universidad Nacional de Tucumán
+https://www.microprocesadores.unt.edu.ar/
+
+Copyright (c) 2022-2023, Esteban Volentini <evolentini@herrera.unt.edu.ar>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief CRC kernels host microbenchmark
+ **
+ ** Measures the throughput of every CRC kernel on the host and checks that all of them produce
+ ** the same value. It is not part of the unit tests, build and run it with:
+ **
+ **     gcc -O2 -DCRC_ALL_KERNELS -I module/preat/inc module/preat/test/bench/bench_crc.c \
+ **         module/preat/src/crc.c -o bench_crc && ./bench_crc
+ **
+ ** \addtogroup preat PREAT
+ ** \brief Protocol for Remote Excecution of Automated Tests
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "crc.h"
+#include <stdio.h>
+#include <time.h>
+
+/* === Macros definitions ====================================================================== */
+
+#define BENCH_BYTES_PER_SIZE (64u * 1024u * 1024u)
+
+/* === Private data type declarations ========================================================== */
+
+typedef crc_t (*crc_kernel_t)(crc_t crc, const void * data, size_t data_len);
+
+typedef struct bench_kernel_s {
+    const char * name;
+    crc_kernel_t update;
+} bench_kernel_t;
+
+/* === Private variable definitions ============================================================ */
+
+static const bench_kernel_t KERNELS[] = {
+    {"nibble", crc_update_nibble},
+    {"table", crc_update_table},
+    {"slice4", crc_update_slice4},
+    {"slice8", crc_update_slice8},
+};
+
+static const size_t SIZES[] = {64, 512, 32768};
+
+static unsigned char buffer[32768];
+
+/* === Private function implementation ========================================================= */
+
+static double Now(void) {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+}
+
+/* === Public function implementation ========================================================== */
+
+int main(void) {
+    volatile crc_t sink = 0;
+    crc_t reference, crc;
+    double start, elapsed;
+    size_t size, rounds;
+    int result = 0;
+
+    for (size_t index = 0; index < sizeof(buffer); index++) {
+        buffer[index] = (unsigned char)(index * 31 + 7);
+    }
+
+    printf("%-8s %8s %10s %10s\n", "kernel", "size", "MB/s", "ns/byte");
+    for (size_t s = 0; s < sizeof(SIZES) / sizeof(SIZES[0]); s++) {
+        size = SIZES[s];
+        rounds = BENCH_BYTES_PER_SIZE / size;
+        reference = crc_update_table(crc_init(), buffer, size);
+        for (size_t k = 0; k < sizeof(KERNELS) / sizeof(KERNELS[0]); k++) {
+            crc = KERNELS[k].update(crc_init(), buffer, size);
+            if (crc != reference) {
+                printf("%-8s %8zu mismatch 0x%04x != 0x%04x\n", KERNELS[k].name, size,
+                       (unsigned)crc, (unsigned)reference);
+                result = 1;
+            }
+            start = Now();
+            for (size_t round = 0; round < rounds; round++) {
+                sink ^= KERNELS[k].update(sink, buffer, size);
+            }
+            elapsed = Now() - start;
+            printf("%-8s %8zu %10.1f %10.3f\n", KERNELS[k].name, size,
+                   (double)BENCH_BYTES_PER_SIZE / elapsed / 1e6,
+                   elapsed * 1e9 / (double)BENCH_BYTES_PER_SIZE);
+        }
+    }
+    return result;
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
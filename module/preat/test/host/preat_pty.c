@@ -0,0 +1,435 @@
+/************************************************************************************************
+Copyright (c) 2022-2023, Laboratorio de Microprocesadores
+Facultad de Ciencias Exactas y Tecnología, Universidad Nacional de Tucumán
+https://www.microprocesadores.unt.edu.ar/
+
+Copyright (c) 2022-2023, Esteban Volentini <evolentini@herrera.unt.edu.ar>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief PREAT server on a Linux pseudo terminal
+ **
+ ** Runs the protocol engine and the serial server on the host using pseudo terminals as the
+ ** transport, so the client tools can be exercised without a board by opening the printed slave
+ ** devices. With `-l <links>` it starts one server instance per link, each one served by its own
+ ** thread. With `-n <frames>` a built-in client on each link sends pipelined LINK.Window requests
+ ** through the slave device and the total throughput is reported. It is not part of the unit
+ ** tests, build and run it with:
+ **
+ **     gcc -O2 -pthread -I module/preat/inc -I test/support module/preat/test/host/preat_pty.c \
+ **         module/preat/src/{serial,protocol,crc,blob,assertion,program}.c test/support/fake_sci.c \
+ **         -o preat_pty && ./preat_pty -l 2 -n 100000
+ **
+ ** \addtogroup preat PREAT
+ ** \brief Protocol for Remote Excecution of Automated Tests
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#define _GNU_SOURCE
+#include "assertion.h"
+#include "crc.h"
+#include "program.h"
+#include "protocol.h"
+#include "serial.h"
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+/* === Macros definitions ====================================================================== */
+
+//! Method identifier of the LINK.Window request used by the built-in client
+#define PTY_CLIENT_METHOD 0x030
+
+/* === Private data type declarations ========================================================== */
+
+/**
+ * @brief Pseudo terminal used as the transport of a server instance
+ */
+typedef struct pty_link_s {
+    int master;               /**< Master side, used by the server */
+    int slave;                /**< Slave side, kept open so the master does not see a hang up */
+    int wake;                 /**< Event descriptor used to wake the thread that serves the link */
+    char path[64];            /**< Path of the slave device */
+    preat_server_t server;    /**< Server instance that uses the link */
+    pthread_t task;           /**< Thread that serves the link */
+    pthread_t client;         /**< Thread of the built-in client of the link */
+    unsigned long received;   /**< Number of responses received by the built-in client */
+} * pty_link_t;
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/**
+ * @brief Function to read the bytes available in the master side of the pseudo terminal
+ *
+ * @param port Pointer to the link descriptor
+ * @param data Pointer to the buffer to store the received bytes
+ * @param size Free space in the buffer
+ * @return Number of bytes stored in the buffer
+ */
+static uint16_t PtyReceive(void * port, uint8_t * data, uint16_t size);
+
+/**
+ * @brief Function to write bytes to the master side of the pseudo terminal
+ *
+ * @param port Pointer to the link descriptor
+ * @param data Pointer to the bytes to send
+ * @param size Number of bytes to send
+ * @return Number of bytes accepted by the pseudo terminal
+ */
+static uint16_t PtySend(void * port, const uint8_t * data, uint16_t size);
+
+/**
+ * @brief Function to put a terminal device in raw mode, so the frames are not altered
+ *
+ * @param fd File descriptor of the terminal device
+ * @return true The terminal was configured
+ * @return false The terminal could not be configured
+ */
+static bool PtyRawMode(int fd);
+
+/**
+ * @brief Thread that serves a link, like the server task of the firmware
+ *
+ * @param object Pointer to the link descriptor
+ * @return Always NULL
+ */
+static void * ServerThread(void * object);
+
+/**
+ * @brief Thread of the built-in client that measures the throughput of a link
+ *
+ * @param object Pointer to the link descriptor
+ * @return Always NULL
+ */
+static void * ClientThread(void * object);
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+//! Functions to use a pseudo terminal as the transport of a server
+static const struct preat_transport_s pty_transport = {
+    .receive = PtyReceive,
+    .send = PtySend,
+    .configure = NULL,
+};
+
+//! Links served by the program
+static struct pty_link_s links[PREAT_SERVER_INSTANCES];
+
+//! Locks of the shared protocol state
+static pthread_mutex_t locks[PREAT_LOCK_COUNT];
+
+//! Number of frames to be sent by each built-in client, zero when they are not used
+static unsigned long client_frames;
+
+//! Flag to stop the server threads when the built-in clients end
+static volatile bool running = true;
+
+//! Events set by the inputs and waited by the assertions, like the event group of the firmware
+static event_flags_t input_events;
+
+//! Lock of the events set by the inputs
+static pthread_mutex_t input_lock = PTHREAD_MUTEX_INITIALIZER;
+
+//! Condition signaled when an input sets an event
+static pthread_cond_t input_changed = PTHREAD_COND_INITIALIZER;
+
+/* === Private function implementation ========================================================= */
+
+static uint16_t PtyReceive(void * port, uint8_t * data, uint16_t size) {
+    ssize_t result = read(((pty_link_t)port)->master, data, size);
+
+    return (result > 0) ? (uint16_t)result : 0;
+}
+
+static uint16_t PtySend(void * port, const uint8_t * data, uint16_t size) {
+    ssize_t result = write(((pty_link_t)port)->master, data, size);
+
+    return (result > 0) ? (uint16_t)result : 0;
+}
+
+static bool PtyRawMode(int fd) {
+    struct termios settings;
+
+    if (tcgetattr(fd, &settings) != 0) {
+        return false;
+    }
+    cfmakeraw(&settings);
+    return tcsetattr(fd, TCSANOW, &settings) == 0;
+}
+
+static bool PtyOpen(pty_link_t link) {
+    link->master = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if ((link->master < 0) || (grantpt(link->master) != 0) || (unlockpt(link->master) != 0)) {
+        return false;
+    }
+    if (ptsname_r(link->master, link->path, sizeof(link->path)) != 0) {
+        return false;
+    }
+    link->slave = open(link->path, O_RDWR | O_NOCTTY);
+    link->wake = eventfd(0, EFD_NONBLOCK);
+    return (link->slave >= 0) && (link->wake >= 0) && PtyRawMode(link->slave);
+}
+
+static double Now(void) {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+}
+
+static void * ServerThread(void * object) {
+    pty_link_t link = object;
+    uint8_t frame[PREAT_FRAME_EXTENDED_LENGTH];
+    struct pollfd events[2] = {
+        {.fd = link->master, .events = POLLIN},
+        {.fd = link->wake, .events = POLLIN},
+    };
+    preat_error_t status;
+    uint64_t count;
+    uint32_t wait;
+
+    while (running) {
+        /* The wait ends early when the window of a background assertion ends, unless a bulk
+           transfer holds back its notification */
+        wait = ServerTransmitHeld(link->server) ? PREAT_LINK_CHECK_PERIOD
+                                                : AssertPendingTime(link->server);
+        wait = (wait < PREAT_LINK_CHECK_PERIOD) ? wait : PREAT_LINK_CHECK_PERIOD;
+        if (poll(events, 2, (int)wait) > 0) {
+            if (events[0].revents != 0) {
+                ServerReceiveEvent(link->server, false);
+            }
+            if (events[1].revents != 0) {
+                (void)read(link->wake, &count, sizeof(count));
+            }
+        }
+        ServerCheckLink(link->server);
+        while (ServerReceiveCommand(link->server, frame, &status)) {
+            PreatExecuteChecked(frame, status, link->server);
+            while (!ServerTransmitResponse(link->server, frame)) {
+                ServerTransmitEvent(link->server);
+            }
+        }
+        while (!ServerTransmitHeld(link->server) && AssertNotification(link->server, frame)) {
+            while (!ServerTransmitFrame(link->server, frame)) {
+                ServerTransmitEvent(link->server);
+            }
+        }
+        ServerTransmitEvent(link->server);
+    }
+    return NULL;
+}
+
+static void * ClientThread(void * object) {
+    pty_link_t link = object;
+    uint8_t request[6], response[PREAT_FRAME_EXTENDED_LENGTH];
+    unsigned long sent = 0;
+    size_t length = 0, expected;
+    ssize_t result;
+    crc_t crc;
+    int fd;
+
+    fd = open(link->path, O_RDWR | O_NOCTTY);
+    if ((fd < 0) || !PtyRawMode(fd)) {
+        perror(link->path);
+        return NULL;
+    }
+
+    while (link->received < client_frames) {
+        while ((sent < client_frames) && (sent - link->received < PREAT_PIPELINE_DEPTH)) {
+            request[0] = PREAT_SEQUENCED_FRAME | sizeof(request);
+            request[1] = (uint8_t)sent;
+            request[2] = (uint8_t)(PTY_CLIENT_METHOD >> 4);
+            request[3] = (uint8_t)(PTY_CLIENT_METHOD << 4);
+            crc = crc_finalize(crc_update(crc_init(), request, 4));
+            request[4] = (uint8_t)(crc >> 8);
+            request[5] = (uint8_t)crc;
+            if (write(fd, request, sizeof(request)) != sizeof(request)) {
+                perror(link->path);
+                break;
+            }
+            sent++;
+        }
+
+        result = read(fd, &response[length], sizeof(response) - length);
+        if (result <= 0) {
+            perror(link->path);
+            break;
+        }
+        length += (size_t)result;
+        while (length > 0) {
+            expected = response[0] & ~PREAT_SEQUENCED_FRAME;
+            if ((expected < PREAT_FRAME_MIN_LENGTH) || (expected > length)) {
+                break;
+            }
+            memmove(response, &response[expected], length - expected);
+            length -= expected;
+            link->received++;
+        }
+    }
+    close(fd);
+    return NULL;
+}
+
+/* === Public function implementation ========================================================== */
+
+uint32_t ServerTimestamp(void) {
+    return (uint32_t)(Now() * 1000);
+}
+
+uint32_t PreatTimestamp(void) {
+    return (uint32_t)(Now() * 1000000);
+}
+
+void PreatLock(preat_lock_t lock) {
+    pthread_mutex_lock(&locks[lock]);
+}
+
+void PreatUnlock(preat_lock_t lock) {
+    pthread_mutex_unlock(&locks[lock]);
+}
+
+void AssertSetEvent(event_id_t id) {
+    pthread_mutex_lock(&input_lock);
+    input_events |= id;
+    pthread_cond_broadcast(&input_changed);
+    pthread_mutex_unlock(&input_lock);
+}
+
+void AssertWakeContext(void * context) {
+    uint64_t count = 1;
+
+    for (int index = 0; index < PREAT_SERVER_INSTANCES; index++) {
+        if ((links[index].server != NULL) && (links[index].server == context)) {
+            (void)write(links[index].wake, &count, sizeof(count));
+        }
+    }
+}
+
+event_flags_t AssertWaitEvents(event_flags_t events, uint32_t timeout) {
+    struct timespec deadline;
+    event_flags_t result;
+
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += timeout / 1000;
+    deadline.tv_nsec += (long)(timeout % 1000) * 1000000;
+    if (deadline.tv_nsec >= 1000000000) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000;
+    }
+
+    /* Without events to wait it only sleeps, like the firmware does with a zero mask */
+    pthread_mutex_lock(&input_lock);
+    while (((input_events & events) == 0) &&
+           (pthread_cond_timedwait(&input_changed, &input_lock, &deadline) == 0)) {
+    }
+    result = input_events & events;
+    input_events &= ~result;
+    pthread_mutex_unlock(&input_lock);
+    return result;
+}
+
+void ProgramDelay(uint32_t delay) {
+    usleep(delay * 1000);
+}
+
+int main(int argc, char * argv[]) {
+    struct preat_server_counters_s counters;
+    pthread_mutexattr_t attributes;
+    unsigned long count = 1, total = 0;
+    double start, elapsed;
+    int option;
+
+    while ((option = getopt(argc, argv, "l:n:")) != -1) {
+        if (option == 'l') {
+            count = strtoul(optarg, NULL, 0);
+        } else if (option == 'n') {
+            client_frames = strtoul(optarg, NULL, 0);
+        } else {
+            count = 0;
+            break;
+        }
+    }
+    if ((count == 0) || (count > PREAT_SERVER_INSTANCES) || (optind != argc)) {
+        fprintf(stderr, "usage: %s [-l links, up to %d] [-n frames]\n", argv[0],
+                PREAT_SERVER_INSTANCES);
+        return 2;
+    }
+
+    pthread_mutexattr_init(&attributes);
+    pthread_mutexattr_settype(&attributes, PTHREAD_MUTEX_RECURSIVE);
+    for (int index = 0; index < PREAT_LOCK_COUNT; index++) {
+        pthread_mutex_init(&locks[index], &attributes);
+    }
+
+    for (unsigned long index = 0; index < count; index++) {
+        if (!PtyOpen(&links[index])) {
+            perror("pty");
+            return 1;
+        }
+        links[index].server = ServerStart(&pty_transport, &links[index]);
+        printf("PREAT server %lu on %s\n", index, links[index].path);
+    }
+    fflush(stdout);
+
+    start = Now();
+    for (unsigned long index = 0; index < count; index++) {
+        pthread_create(&links[index].task, NULL, ServerThread, &links[index]);
+        if (client_frames > 0) {
+            pthread_create(&links[index].client, NULL, ClientThread, &links[index]);
+        }
+    }
+    if (client_frames == 0) {
+        pthread_join(links[0].task, NULL);
+    }
+    for (unsigned long index = 0; index < count; index++) {
+        pthread_join(links[index].client, NULL);
+        total += links[index].received;
+    }
+    elapsed = Now() - start;
+    running = false;
+
+    printf("%lu frames on %lu links in %.3f s, %.0f frames/s\n", total, count, elapsed,
+           (double)total / elapsed);
+    for (unsigned long index = 0; index < count; index++) {
+        pthread_join(links[index].task, NULL);
+        ServerGetCounters(links[index].server, &counters);
+        printf("link %lu: received %u, crc errors %u, overflows %u, framing errors %u\n", index,
+               counters.received, counters.crc, counters.overflows, counters.framing);
+        close(links[index].slave);
+        close(links[index].master);
+        close(links[index].wake);
+    }
+    return 0;
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
@@ -33,6 +33,10 @@ SPDX-License-Identifier: MIT
 
 #include "unity.h"
 #include "assertion.h"
+#include "crc.h"
+#include "protocol.h"
+#include "fake_events.h"
+#include "fake_lock.h"
 #include <string.h>
 
 /* === Macros definitions ====================================================================== */
@@ -41,6 +45,8 @@ SPDX-License-Identifier: MIT
 
 #define TIMEOUT        5000
 
+#define SHORT_TIMEOUT  50
+
 #define FakeReset(var) memset(&var, 0, sizeof(var));
 
 /* === Private data type declarations ========================================================== */
@@ -53,78 +59,133 @@ SPDX-License-Identifier: MIT
 
 /* === Private variable definitions ============================================================ */
 
-static struct preat_parameter_s fake_parameters[] = {
-    {TYPE_UINT8, 3},
+static const uint8_t fake_frame[] = {0x10, 0x03};
+
+static const struct preat_parameters_s fake_parameters[] = {{
+    .data = fake_frame,
+    .signature = PREAT_PARAMETER(0, TYPE_UINT8),
+    .offsets = {1},
+}};
+
+static const uint8_t assert_frame[] = {
+    0x33, 0x00, 0x00, DELAY >> 8, DELAY & 0xFF, 0x00, 0x00, TIMEOUT >> 8, TIMEOUT & 0xFF,
+    0x11, 0x01, 0x00,
 };
 
-static struct preat_parameter_s assert_parameters[] = {
-    {TYPE_UINT32, DELAY},
-    {TYPE_UINT32, TIMEOUT},
-    {TYPE_UINT8, 1},
-    {TYPE_UINT8, 0},
+static const uint8_t short_frame[] = {
+    0x33, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, SHORT_TIMEOUT, 0x11, 0x01, 0x00,
 };
 
+static uint8_t operator_frame[sizeof(assert_frame)];
+
+static const struct preat_parameters_s operator_parameters[] = {{
+    .data = operator_frame,
+    .signature = PREAT_PARAMETER(0, TYPE_UINT32) | PREAT_PARAMETER(1, TYPE_UINT32) |
+                 PREAT_PARAMETER(2, TYPE_UINT8) | PREAT_PARAMETER(3, TYPE_UINT8),
+    .offsets = {1, 5, 10, 11},
+}};
+
+static const struct preat_parameters_s assert_parameters[] = {{
+    .data = assert_frame,
+    .signature = PREAT_PARAMETER(0, TYPE_UINT32) | PREAT_PARAMETER(1, TYPE_UINT32) |
+                 PREAT_PARAMETER(2, TYPE_UINT8) | PREAT_PARAMETER(3, TYPE_UINT8),
+    .offsets = {1, 5, 10, 11},
+}};
+
+static uint8_t links[2];
+
+static struct preat_results_s owner_results[1];
+
+static const struct preat_parameters_s owner_parameters[] = {{
+    .data = assert_frame,
+    .signature = PREAT_PARAMETER(0, TYPE_UINT32) | PREAT_PARAMETER(1, TYPE_UINT32) |
+                 PREAT_PARAMETER(2, TYPE_UINT8) | PREAT_PARAMETER(3, TYPE_UINT8),
+    .offsets = {1, 5, 10, 11},
+    .results = owner_results,
+}};
+
+static const struct preat_parameters_s short_parameters[] = {{
+    .data = short_frame,
+    .signature = PREAT_PARAMETER(0, TYPE_UINT32) | PREAT_PARAMETER(1, TYPE_UINT32) |
+                 PREAT_PARAMETER(2, TYPE_UINT8) | PREAT_PARAMETER(3, TYPE_UINT8),
+    .offsets = {1, 5, 10, 11},
+    .results = owner_results,
+}};
+
+static const struct preat_parameters_s owner_output[] = {{
+    .data = fake_frame,
+    .signature = PREAT_PARAMETER(0, TYPE_UINT8),
+    .offsets = {1},
+    .results = owner_results,
+}};
+
+static uint8_t result_frame[] = {0x10, 0x00};
+
+static struct preat_results_s result_results[1];
+
+static const struct preat_parameters_s result_parameters[] = {{
+    .data = result_frame,
+    .signature = PREAT_PARAMETER(0, TYPE_UINT8),
+    .offsets = {1},
+    .results = result_results,
+}};
+
 struct input_state_s {
     uint32_t dummy_field;
 } fake_state;
 
 static struct fake_cleanup_s {
-    bool called;
+    uint8_t called;
     input_state_t state;
+    event_id_t id;
 } fake_cleanup;
 
 static struct fake_method_s {
     bool called;
-    preat_parameter_t parameters;
+    preat_parameters_t parameters;
     uint8_t count;
     preat_error_t result;
 } fake_method;
 
-static struct fake_events_s {
-    uint8_t called;
-    struct events_call_s {
-        event_flags_t events;
-        uint32_t timeout;
-        bool wait_for_all;
-        event_flags_t result;
-    } calls[8];
-} fake_events;
-
 /* === Private function implementation ========================================================= */
 
-void FakeCleanup(input_state_t state) {
-    fake_cleanup.called = true;
+void FakeCleanup(input_state_t state, event_id_t id) {
+    fake_cleanup.called++;
     fake_cleanup.state = state;
+    fake_cleanup.id = id;
 }
 
-preat_error_t FakeMethod(const preat_parameter_t parameters, uint8_t count) {
+preat_error_t FakeMethod(preat_parameters_t parameters, uint8_t count) {
     fake_method.called = true;
     fake_method.parameters = parameters;
     fake_method.count = count;
     return fake_method.result;
 }
 
-/* === Public function implementation ========================================================= */
-
-event_flags_t AssertWaitEvents(event_flags_t events, uint32_t timeout, bool wait_for_all) {
-    event_flags_t result = 0;
-
-    if (fake_events.called < sizeof(fake_events.calls) / sizeof(fake_events.calls[0]) - 1) {
-        fake_events.calls[fake_events.called].events = events;
-        fake_events.calls[fake_events.called].timeout = timeout;
-        fake_events.calls[fake_events.called].wait_for_all = wait_for_all;
-        result = fake_events.calls[fake_events.called].result;
-        fake_events.called++;
-    } else {
-        TEST_FAIL_MESSAGE("No more space to save calls");
+static preat_error_t StartWithOperator(uint8_t conditions, uint8_t code, event_id_t * ids) {
+    preat_error_t result;
+    uint8_t index;
+
+    memcpy(operator_frame, assert_frame, sizeof(assert_frame));
+    operator_frame[10] = conditions;
+    operator_frame[11] = code;
+    result = AssertStart(operator_parameters, 4);
+    for (index = 0; (result == PREAT_NO_ERROR) && (index < conditions); index++) {
+        ids[index] = AssertRegisterEvent(NULL, FakeCleanup, &fake_state);
     }
     return result;
 }
 
+/* === Public function implementation ========================================================= */
+
 void setUp(void) {
     FakeReset(fake_method);
     FakeReset(fake_cleanup);
-    FakeReset(fake_events);
+    FakeReset(owner_results);
+    FakeReset(result_results);
+    owner_results->context = &links[0];
+    FakeEventsReset();
+    FakeLockReset();
 }
 
 void tearDown(void) {
@@ -133,30 +194,31 @@ void tearDown(void) {
 
 void test_assertion_defined_and_event_occurs_as_expected(void) {
     TEST_ASSERT_EQUAL(PREAT_NO_ERROR, AssertStart(assert_parameters, 4));
-    event_id_t id = AssertRegisterEvent(FakeCleanup, &fake_state);
+    event_id_t id = AssertRegisterEvent(NULL, FakeCleanup, &fake_state);
     TEST_ASSERT_NOT_EQUAL(ASSERT_EVENT_INVALID_ID, id);
 
     fake_method.result = PREAT_NO_ERROR;
-    fake_events.calls[1].result = id;
+    fake_events->calls[1].result = id;
+    fake_events->calls[1].elapsed = (DELAY + 10) * 1000;
     TEST_ASSERT_EQUAL(PREAT_NO_ERROR, AssertExecute(FakeMethod, fake_parameters, 1));
 
     TEST_ASSERT_TRUE(fake_method.called);
     TEST_ASSERT_EQUAL(fake_parameters, fake_method.parameters);
     TEST_ASSERT_EQUAL(1, fake_method.count);
 
-    TEST_ASSERT_EQUAL(2, fake_events.called);
-    TEST_ASSERT_EQUAL(DELAY, fake_events.calls[0].timeout);
-    TEST_ASSERT_FALSE(fake_events.calls[0].wait_for_all);
-    TEST_ASSERT_EQUAL(TIMEOUT, fake_events.calls[1].timeout);
-    TEST_ASSERT_TRUE(fake_events.calls[1].wait_for_all);
+    TEST_ASSERT_EQUAL(2, fake_events->called);
+    TEST_ASSERT_EQUAL(0, fake_events->calls[0].timeout);
+    TEST_ASSERT_EQUAL(DELAY + TIMEOUT, fake_events->calls[1].timeout);
+    TEST_ASSERT_EQUAL(id, fake_events->calls[1].events);
 
     TEST_ASSERT_TRUE(fake_cleanup.called);
     TEST_ASSERT_EQUAL(&fake_state, fake_cleanup.state);
+    TEST_ASSERT_EQUAL(id, fake_cleanup.id);
 }
 
 void test_assertion_defined_and_event_not_occurs(void) {
     TEST_ASSERT_EQUAL(PREAT_NO_ERROR, AssertStart(assert_parameters, 4));
-    event_id_t id = AssertRegisterEvent(FakeCleanup, &fake_state);
+    event_id_t id = AssertRegisterEvent(NULL, FakeCleanup, &fake_state);
     TEST_ASSERT_NOT_EQUAL(ASSERT_EVENT_INVALID_ID, id);
 
     fake_method.result = PREAT_NO_ERROR;
@@ -166,11 +228,9 @@ void test_assertion_defined_and_event_not_occurs(void) {
     TEST_ASSERT_EQUAL(fake_parameters, fake_method.parameters);
     TEST_ASSERT_EQUAL(1, fake_method.count);
 
-    TEST_ASSERT_EQUAL(2, fake_events.called);
-    TEST_ASSERT_EQUAL(DELAY, fake_events.calls[0].timeout);
-    TEST_ASSERT_FALSE(fake_events.calls[0].wait_for_all);
-    TEST_ASSERT_EQUAL(TIMEOUT, fake_events.calls[1].timeout);
-    TEST_ASSERT_TRUE(fake_events.calls[1].wait_for_all);
+    TEST_ASSERT_EQUAL(3, fake_events->called);
+    TEST_ASSERT_EQUAL(DELAY + TIMEOUT, fake_events->calls[1].timeout);
+    TEST_ASSERT_EQUAL(0, fake_events->calls[2].timeout);
 
     TEST_ASSERT_TRUE(fake_cleanup.called);
     TEST_ASSERT_EQUAL(&fake_state, fake_cleanup.state);
@@ -178,25 +238,39 @@ void test_assertion_defined_and_event_not_occurs(void) {
 
 void test_assertion_defined_and_event_occur_before_than_expected(void) {
     TEST_ASSERT_EQUAL(PREAT_NO_ERROR, AssertStart(assert_parameters, 4));
-    event_id_t id = AssertRegisterEvent(FakeCleanup, &fake_state);
+    event_id_t id = AssertRegisterEvent(NULL, FakeCleanup, &fake_state);
     TEST_ASSERT_NOT_EQUAL(ASSERT_EVENT_INVALID_ID, id);
 
     fake_method.result = PREAT_NO_ERROR;
-    fake_events.calls[0].result = id;
+    fake_events->calls[1].result = id;
+    fake_events->calls[1].elapsed = DELAY / 2 * 1000;
     TEST_ASSERT_EQUAL(PREAT_TOO_EARLY_ERROR, AssertExecute(FakeMethod, fake_parameters, 1));
 
     TEST_ASSERT_TRUE(fake_method.called);
     TEST_ASSERT_EQUAL(fake_parameters, fake_method.parameters);
     TEST_ASSERT_EQUAL(1, fake_method.count);
 
-    TEST_ASSERT_EQUAL(1, fake_events.called);
+    TEST_ASSERT_EQUAL(2, fake_events->called);
 
     TEST_ASSERT_TRUE(fake_cleanup.called);
     TEST_ASSERT_EQUAL(&fake_state, fake_cleanup.state);
 }
+
+void test_assertion_ignores_events_before_the_output_method(void) {
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR, AssertStart(assert_parameters, 4));
+    event_id_t id = AssertRegisterEvent(NULL, FakeCleanup, &fake_state);
+
+    fake_method.result = PREAT_NO_ERROR;
+    fake_events->calls[0].result = id;
+    fake_events->calls[1].result = id;
+    fake_events->calls[1].elapsed = (DELAY + 1) * 1000;
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR, AssertExecute(FakeMethod, fake_parameters, 1));
+    TEST_ASSERT_EQUAL(0, fake_events->calls[0].timeout);
+}
+
 void test_assertion_defined_and_output_method_raises_an_error(void) {
     TEST_ASSERT_EQUAL(PREAT_NO_ERROR, AssertStart(assert_parameters, 4));
-    event_id_t id = AssertRegisterEvent(FakeCleanup, &fake_state);
+    event_id_t id = AssertRegisterEvent(NULL, FakeCleanup, &fake_state);
     TEST_ASSERT_NOT_EQUAL(ASSERT_EVENT_INVALID_ID, id);
 
     fake_method.result = PREAT_PARAMETERS_ERROR;
@@ -206,43 +280,437 @@ void test_assertion_defined_and_output_method_raises_an_error(void) {
     TEST_ASSERT_EQUAL(fake_parameters, fake_method.parameters);
     TEST_ASSERT_EQUAL(1, fake_method.count);
 
-    TEST_ASSERT_EQUAL(0, fake_events.called);
+    TEST_ASSERT_EQUAL(1, fake_events->called);
 
     TEST_ASSERT_TRUE(fake_cleanup.called);
     TEST_ASSERT_EQUAL(&fake_state, fake_cleanup.state);
 }
 
-void test_start_two_assert_raise_error(void) {
+void test_start_assert_before_inputs_of_previous_raise_error(void) {
     TEST_ASSERT_EQUAL(PREAT_NO_ERROR, AssertStart(assert_parameters, 4));
     TEST_ASSERT_EQUAL(PREAT_REDEFINED_ERROR, AssertStart(assert_parameters, 4));
 }
 
+void test_start_returns_the_handle_of_the_assertion(void) {
+    static const uint8_t EXPECTED[] = {0x10, 0x00};
+
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR, AssertStart(owner_parameters, 4));
+    TEST_ASSERT_EQUAL(1, owner_results->count);
+    TEST_ASSERT_EQUAL_MEMORY(EXPECTED, owner_results->data, sizeof(EXPECTED));
+    AssertRegisterEvent(&links[0], FakeCleanup, &fake_state);
+
+    FakeReset(owner_results);
+    owner_results->context = &links[0];
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR, AssertStart(short_parameters, 4));
+    TEST_ASSERT_EQUAL(0x01, owner_results->data[1]);
+}
+
+void test_start_more_assertions_than_the_pool_raise_error(void) {
+    uint8_t index;
+
+    for (index = 0; index < PREAT_ASSERTIONS; index++) {
+        TEST_ASSERT_EQUAL(PREAT_NO_ERROR, AssertStart(assert_parameters, 4));
+        AssertRegisterEvent(NULL, FakeCleanup, &fake_state);
+    }
+    TEST_ASSERT_EQUAL(PREAT_MEMORY_ERROR, AssertStart(assert_parameters, 4));
+}
+
 void test_start_and_execute_without_append_cleanups_raise_error(void) {
     TEST_ASSERT_EQUAL(PREAT_NO_ERROR, AssertStart(assert_parameters, 4));
     TEST_ASSERT_EQUAL(PREAT_UNDEFINED_ERROR, AssertExecute(FakeMethod, fake_parameters, 1));
 
     TEST_ASSERT_FALSE(fake_method.called);
-    TEST_ASSERT_EQUAL(0, fake_events.called);
+    TEST_ASSERT_EQUAL(0, fake_events->called);
     TEST_ASSERT_FALSE(fake_cleanup.called);
 }
 
 void test_add_more_inputs_to_assert_raise_error(void) {
     TEST_ASSERT_EQUAL(PREAT_NO_ERROR, AssertStart(assert_parameters, 4));
 
-    event_id_t id = AssertRegisterEvent(FakeCleanup, &fake_state);
+    event_id_t id = AssertRegisterEvent(NULL, FakeCleanup, &fake_state);
     TEST_ASSERT_NOT_EQUAL(ASSERT_EVENT_INVALID_ID, id);
 
-    id = AssertRegisterEvent(FakeCleanup, &fake_state);
+    id = AssertRegisterEvent(NULL, FakeCleanup, &fake_state);
     TEST_ASSERT_EQUAL(ASSERT_EVENT_INVALID_ID, id);
 }
 
 void test_assert_in_undefined_on_start(void) {
-    TEST_ASSERT_FALSE(AssertIsDefined());
+    TEST_ASSERT_FALSE(AssertIsDefined(NULL));
 }
 
 void test_assert_in_pendding_after_start_the_definition(void) {
     TEST_ASSERT_EQUAL(PREAT_NO_ERROR, AssertStart(assert_parameters, 4));
-    TEST_ASSERT_TRUE(AssertIsDefined());
+    TEST_ASSERT_TRUE(AssertIsDefined(NULL));
+}
+
+void test_assert_lock_released_after_each_operation(void) {
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR, AssertStart(assert_parameters, 4));
+    TEST_ASSERT_EQUAL(0, fake_locks[PREAT_LOCK_ASSERTION].depth);
+
+    AssertRegisterEvent(NULL, FakeCleanup, &fake_state);
+    TEST_ASSERT_EQUAL(0, fake_locks[PREAT_LOCK_ASSERTION].depth);
+
+    AssertExecute(FakeMethod, fake_parameters, 1);
+    TEST_ASSERT_EQUAL(0, fake_locks[PREAT_LOCK_ASSERTION].depth);
+}
+
+void test_assert_defined_only_for_the_context_that_started_it(void) {
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR, AssertStart(owner_parameters, 4));
+    TEST_ASSERT_TRUE(AssertIsDefined(&links[0]));
+    TEST_ASSERT_FALSE(AssertIsDefined(&links[1]));
+    TEST_ASSERT_FALSE(AssertIsDefined(NULL));
+}
+
+void test_add_inputs_from_other_context_raise_error(void) {
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR, AssertStart(owner_parameters, 4));
+    TEST_ASSERT_EQUAL(ASSERT_EVENT_INVALID_ID,
+                      AssertRegisterEvent(&links[1], FakeCleanup, &fake_state));
+    TEST_ASSERT_NOT_EQUAL(ASSERT_EVENT_INVALID_ID,
+                          AssertRegisterEvent(&links[0], FakeCleanup, &fake_state));
+}
+
+void test_assertions_of_other_contexts_defined_at_the_same_time(void) {
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR, AssertStart(owner_parameters, 4));
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR, AssertStart(assert_parameters, 4));
+    TEST_ASSERT_TRUE(AssertIsDefined(&links[0]));
+    TEST_ASSERT_TRUE(AssertIsDefined(NULL));
+}
+
+void test_two_assertions_evaluated_on_independent_windows(void) {
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR, AssertStart(owner_parameters, 4));
+    event_id_t slow = AssertRegisterEvent(&links[0], FakeCleanup, &fake_state);
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR, AssertStart(short_parameters, 4));
+    event_id_t fast = AssertRegisterEvent(&links[0], FakeCleanup, &fake_state);
+    TEST_ASSERT_NOT_EQUAL(slow, fast);
+
+    fake_events->calls[1].result = fast;
+    fake_events->calls[1].elapsed = 20 * 1000;
+    fake_events->calls[2].result = slow;
+    fake_events->calls[2].elapsed = 200 * 1000;
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR, AssertExecute(FakeMethod, owner_output, 1));
+
+    TEST_ASSERT_EQUAL(3, fake_events->called);
+    TEST_ASSERT_EQUAL(slow | fast, fake_events->calls[0].events);
+    TEST_ASSERT_EQUAL(SHORT_TIMEOUT, fake_events->calls[1].timeout);
+    TEST_ASSERT_EQUAL(slow | fast, fake_events->calls[1].events);
+    TEST_ASSERT_EQUAL(DELAY + TIMEOUT - 20, fake_events->calls[2].timeout);
+    TEST_ASSERT_EQUAL(slow, fake_events->calls[2].events);
+    TEST_ASSERT_EQUAL(220 * 1000, fake_events->clock);
+
+    TEST_ASSERT_EQUAL(2, fake_cleanup.called);
+    TEST_ASSERT_FALSE(AssertIsDefined(&links[0]));
+}
+
+void test_first_failed_assertion_reported_by_its_handle(void) {
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR, AssertStart(owner_parameters, 4));
+    AssertRegisterEvent(&links[0], FakeCleanup, &fake_state);
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR, AssertStart(short_parameters, 4));
+    AssertRegisterEvent(&links[0], FakeCleanup, &fake_state);
+
+    TEST_ASSERT_EQUAL(PREAT_TIMEOUT_ERROR, AssertExecute(FakeMethod, owner_output, 1));
+    TEST_ASSERT_EQUAL(2, owner_results->failed);
+    TEST_ASSERT_EQUAL(SHORT_TIMEOUT * 1000, fake_events->clock);
+    TEST_ASSERT_EQUAL(2, fake_cleanup.called);
+}
+
+void test_output_method_only_runs_the_assertions_of_its_context(void) {
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR, AssertStart(owner_parameters, 4));
+    AssertRegisterEvent(&links[0], FakeCleanup, &fake_state);
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR, AssertStart(assert_parameters, 4));
+    event_id_t id = AssertRegisterEvent(NULL, FakeCleanup, &fake_state);
+
+    fake_events->calls[1].result = id;
+    fake_events->calls[1].elapsed = (DELAY + 1) * 1000;
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR, AssertExecute(FakeMethod, fake_parameters, 1));
+    TEST_ASSERT_EQUAL(id, fake_events->calls[0].events);
+    TEST_ASSERT_EQUAL(1, fake_cleanup.called);
+    TEST_ASSERT_TRUE(AssertIsDefined(&links[0]));
+}
+
+void test_or_assertion_verified_with_the_first_condition(void) {
+    event_id_t ids[3];
+
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR, StartWithOperator(3, ASSERT_OPERATOR_OR, ids));
+    fake_events->calls[1].result = ids[1];
+    fake_events->calls[1].elapsed = (DELAY + 10) * 1000;
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR, AssertExecute(FakeMethod, fake_parameters, 1));
+
+    TEST_ASSERT_EQUAL(2, fake_events->called);
+    TEST_ASSERT_EQUAL(ids[0] | ids[1] | ids[2], fake_events->calls[1].events);
+    TEST_ASSERT_EQUAL((DELAY + 10) * 1000, fake_events->clock);
+    TEST_ASSERT_EQUAL(3, fake_cleanup.called);
+}
+
+void test_or_assertion_without_conditions_raise_timeout(void) {
+    event_id_t ids[2];
+
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR, StartWithOperator(2, ASSERT_OPERATOR_OR, ids));
+    TEST_ASSERT_EQUAL(PREAT_TIMEOUT_ERROR, AssertExecute(FakeMethod, fake_parameters, 1));
+    TEST_ASSERT_EQUAL((DELAY + TIMEOUT) * 1000, fake_events->clock);
+}
+
+void test_and_assertion_waits_only_the_missing_conditions(void) {
+    event_id_t ids[2];
+
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR, StartWithOperator(2, ASSERT_OPERATOR_AND, ids));
+    fake_events->calls[1].result = ids[0];
+    fake_events->calls[1].elapsed = (DELAY + 10) * 1000;
+    fake_events->calls[2].result = ids[1];
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR, AssertExecute(FakeMethod, fake_parameters, 1));
+
+    TEST_ASSERT_EQUAL(3, fake_events->called);
+    TEST_ASSERT_EQUAL(ids[1], fake_events->calls[2].events);
+    TEST_ASSERT_EQUAL(TIMEOUT - 10, fake_events->calls[2].timeout);
+}
+
+void test_at_least_assertion_verified_with_k_conditions(void) {
+    event_id_t ids[4];
+
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR, StartWithOperator(4, ASSERT_OPERATOR_AT_LEAST | 2, ids));
+    fake_events->calls[1].result = ids[3];
+    fake_events->calls[1].elapsed = (DELAY + 1) * 1000;
+    fake_events->calls[2].result = ids[0];
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR, AssertExecute(FakeMethod, fake_parameters, 1));
+    TEST_ASSERT_EQUAL(3, fake_events->called);
+}
+
+void test_at_least_assertion_with_more_than_declared_raise_error(void) {
+    event_id_t ids[2];
+
+    TEST_ASSERT_EQUAL(PREAT_PARAMETERS_ERROR,
+                      StartWithOperator(2, ASSERT_OPERATOR_AT_LEAST | 3, ids));
+    TEST_ASSERT_EQUAL(PREAT_PARAMETERS_ERROR, StartWithOperator(2, ASSERT_OPERATOR_AT_LEAST, ids));
+    TEST_ASSERT_FALSE(AssertIsDefined(NULL));
+}
+
+void test_unknown_operator_raise_error(void) {
+    event_id_t ids[1];
+
+    TEST_ASSERT_EQUAL(PREAT_PARAMETERS_ERROR, StartWithOperator(1, 0x07, ids));
+    TEST_ASSERT_FALSE(AssertIsDefined(NULL));
+}
+
+void test_sequence_assertion_verified_in_order(void) {
+    event_id_t ids[3];
+
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR, StartWithOperator(3, ASSERT_OPERATOR_SEQUENCE, ids));
+    fake_events->calls[1].result = ids[0];
+    fake_events->calls[1].elapsed = (DELAY + 1) * 1000;
+    fake_events->calls[2].result = ids[1] | ids[2];
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR, AssertExecute(FakeMethod, fake_parameters, 1));
+    TEST_ASSERT_EQUAL(3, fake_events->called);
+}
+
+void test_sequence_assertion_out_of_order_fails_at_once(void) {
+    event_id_t ids[3];
+
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR, StartWithOperator(3, ASSERT_OPERATOR_SEQUENCE, ids));
+    fake_events->calls[1].result = ids[0];
+    fake_events->calls[1].elapsed = (DELAY + 10) * 1000;
+    fake_events->calls[2].result = ids[2];
+    fake_events->calls[2].elapsed = 5 * 1000;
+    TEST_ASSERT_EQUAL(PREAT_SEQUENCE_ERROR, AssertExecute(FakeMethod, fake_parameters, 1));
+
+    TEST_ASSERT_EQUAL(3, fake_events->called);
+    TEST_ASSERT_EQUAL((DELAY + 15) * 1000, fake_events->clock);
+    TEST_ASSERT_EQUAL(3, fake_cleanup.called);
+}
+
+void test_microseconds_window_rejects_events_one_microsecond_early(void) {
+    event_id_t ids[1];
+
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR,
+                      StartWithOperator(1, ASSERT_OPERATOR_AND | ASSERT_OPERATOR_MICROSECONDS, ids));
+    fake_events->calls[1].result = ids[0];
+    fake_events->calls[1].elapsed = DELAY - 1;
+    TEST_ASSERT_EQUAL(PREAT_TOO_EARLY_ERROR, AssertExecute(FakeMethod, fake_parameters, 1));
+    TEST_ASSERT_EQUAL((DELAY + TIMEOUT + 999) / 1000, fake_events->calls[1].timeout);
+}
+
+void test_microseconds_window_accepts_events_at_the_delay(void) {
+    event_id_t ids[1];
+
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR,
+                      StartWithOperator(1, ASSERT_OPERATOR_AND | ASSERT_OPERATOR_MICROSECONDS, ids));
+    fake_events->calls[1].result = ids[0];
+    fake_events->calls[1].elapsed = DELAY;
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR, AssertExecute(FakeMethod, fake_parameters, 1));
+}
+
+void test_microseconds_window_event_after_the_timeout_raise_timeout(void) {
+    event_id_t ids[1];
+
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR,
+                      StartWithOperator(1, ASSERT_OPERATOR_AND | ASSERT_OPERATOR_MICROSECONDS, ids));
+    fake_events->calls[1].result = ids[0];
+    fake_events->calls[1].elapsed = DELAY + TIMEOUT + 1;
+    TEST_ASSERT_EQUAL(PREAT_TIMEOUT_ERROR, AssertExecute(FakeMethod, fake_parameters, 1));
+}
+
+void test_window_longer_than_the_timestamp_range_raise_error(void) {
+    memcpy(operator_frame, assert_frame, sizeof(assert_frame));
+    operator_frame[5] = 0x01;
+    TEST_ASSERT_EQUAL(PREAT_PARAMETERS_ERROR, AssertStart(operator_parameters, 4));
+    TEST_ASSERT_FALSE(AssertIsDefined(NULL));
+
+    operator_frame[11] = ASSERT_OPERATOR_AND | ASSERT_OPERATOR_MICROSECONDS;
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR, AssertStart(operator_parameters, 4));
+}
+
+void test_result_reports_the_time_of_each_condition(void) {
+    static const uint8_t EXPECTED[] = {
+        0x11, 0x02, 0x03, 0x88, 0x00, 0x01, 0xAD, 0xB0, 0x00, 0x01, 0xFB, 0xD0,
+    };
+    event_id_t ids[2];
+
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR, StartWithOperator(2, ASSERT_OPERATOR_AND, ids));
+    fake_events->calls[1].result = ids[0];
+    fake_events->calls[1].elapsed = (DELAY + 10) * 1000;
+    fake_events->calls[2].result = ids[1];
+    fake_events->calls[2].elapsed = 20 * 1000;
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR, AssertExecute(FakeMethod, fake_parameters, 1));
+
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR, AssertResult(result_parameters, 1));
+    TEST_ASSERT_EQUAL(3, result_results->count);
+    TEST_ASSERT_EQUAL_MEMORY(EXPECTED, result_results->data, sizeof(EXPECTED));
+}
+
+void test_result_reports_the_condition_that_occurred_too_early(void) {
+    static const uint8_t EXPECTED[] = {
+        0x11, 0x02, 0x02, 0x88, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x9C, 0x40,
+    };
+    event_id_t ids[2];
+
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR, StartWithOperator(2, ASSERT_OPERATOR_AND, ids));
+    fake_events->calls[1].result = ids[1];
+    fake_events->calls[1].elapsed = 40 * 1000;
+    TEST_ASSERT_EQUAL(PREAT_TOO_EARLY_ERROR, AssertExecute(FakeMethod, fake_parameters, 1));
+
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR, AssertResult(result_parameters, 1));
+    TEST_ASSERT_EQUAL_MEMORY(EXPECTED, result_results->data, sizeof(EXPECTED));
+}
+
+void test_result_of_assertion_not_executed_raise_error(void) {
+    event_id_t ids[1];
+
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR, StartWithOperator(1, ASSERT_OPERATOR_AND, ids));
+    TEST_ASSERT_EQUAL(PREAT_UNDEFINED_ERROR, AssertResult(result_parameters, 1));
+
+    result_frame[1] = PREAT_ASSERTIONS;
+    TEST_ASSERT_EQUAL(PREAT_PARAMETERS_ERROR, AssertResult(result_parameters, 1));
+    result_frame[1] = 0;
+}
+
+void test_result_only_available_to_the_context_that_executed_it(void) {
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR, AssertStart(owner_parameters, 4));
+    AssertRegisterEvent(&links[0], FakeCleanup, &fake_state);
+    AssertExecute(FakeMethod, owner_output, 1);
+
+    TEST_ASSERT_EQUAL(PREAT_UNDEFINED_ERROR, AssertResult(result_parameters, 1));
+    result_results->context = &links[0];
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR, AssertResult(result_parameters, 1));
+}
+
+void test_background_assertion_does_not_block_the_output_method(void) {
+    event_id_t ids[1];
+    uint8_t frame[PREAT_FRAME_MAX_LENGTH];
+
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR,
+                      StartWithOperator(1, ASSERT_OPERATOR_AND | ASSERT_OPERATOR_BACKGROUND, ids));
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR, AssertExecute(FakeMethod, fake_parameters, 1));
+    TEST_ASSERT_TRUE(fake_method.called);
+    TEST_ASSERT_EQUAL(1, fake_events->called);
+    TEST_ASSERT_FALSE(fake_cleanup.called);
+    TEST_ASSERT_FALSE(AssertIsDefined(NULL));
+
+    fake_events->clock += 40 * 1000;
+    TEST_ASSERT_FALSE(AssertNotification(NULL, frame));
+    TEST_ASSERT_EQUAL(DELAY + TIMEOUT - 40, AssertPendingTime(NULL));
+    TEST_ASSERT_EQUAL(UINT32_MAX, AssertPendingTime(&links[0]));
+}
+
+void test_background_assertion_notified_when_event_occurs(void) {
+    static const uint8_t EXPECTED[] = {0x08, 0x05, 0x12, 0x11, 0x00, 0x00, 0xec, 0x95};
+    event_id_t ids[1];
+    uint8_t frame[PREAT_FRAME_MAX_LENGTH];
+
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR,
+                      StartWithOperator(1, ASSERT_OPERATOR_AND | ASSERT_OPERATOR_BACKGROUND, ids));
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR, AssertExecute(FakeMethod, fake_parameters, 1));
+
+    fake_events->clock += (DELAY + 10) * 1000;
+    AssertSignalEvents(ids[0]);
+    TEST_ASSERT_EQUAL(1, fake_events->woken);
+    TEST_ASSERT_NULL(fake_events->context);
+
+    TEST_ASSERT_TRUE(AssertNotification(NULL, frame));
+    TEST_ASSERT_EQUAL_MEMORY(EXPECTED, frame, sizeof(EXPECTED));
+    TEST_ASSERT_EQUAL(1, fake_cleanup.called);
+    TEST_ASSERT_FALSE(AssertNotification(NULL, frame));
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR, AssertResult(result_parameters, 1));
+}
+
+void test_background_assertion_notified_on_timeout(void) {
+    static const uint8_t EXPECTED[] = {0x08, 0x05, 0x12, 0x11, 0x00, 0x05, 0xda, 0xde};
+    event_id_t ids[1];
+    uint8_t frame[PREAT_FRAME_MAX_LENGTH];
+
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR,
+                      StartWithOperator(1, ASSERT_OPERATOR_AND | ASSERT_OPERATOR_BACKGROUND, ids));
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR, AssertExecute(FakeMethod, fake_parameters, 1));
+
+    fake_events->clock += (DELAY + TIMEOUT) * 1000;
+    TEST_ASSERT_EQUAL(0, AssertPendingTime(NULL));
+    TEST_ASSERT_TRUE(AssertNotification(NULL, frame));
+    TEST_ASSERT_EQUAL_MEMORY(EXPECTED, frame, sizeof(EXPECTED));
+    TEST_ASSERT_EQUAL(UINT32_MAX, AssertPendingTime(NULL));
+}
+
+void test_background_assertion_released_when_output_method_fails(void) {
+    event_id_t ids[1];
+    uint8_t frame[PREAT_FRAME_MAX_LENGTH];
+
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR,
+                      StartWithOperator(1, ASSERT_OPERATOR_AND | ASSERT_OPERATOR_BACKGROUND, ids));
+    fake_method.result = PREAT_PARAMETERS_ERROR;
+    TEST_ASSERT_EQUAL(PREAT_PARAMETERS_ERROR, AssertExecute(FakeMethod, fake_parameters, 1));
+    TEST_ASSERT_EQUAL(1, fake_cleanup.called);
+    TEST_ASSERT_FALSE(AssertNotification(NULL, frame));
+}
+
+void test_abort_background_assertion_runs_the_cleanups(void) {
+    event_id_t ids[2];
+    uint8_t frame[PREAT_FRAME_MAX_LENGTH];
+
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR,
+                      StartWithOperator(2, ASSERT_OPERATOR_AND | ASSERT_OPERATOR_BACKGROUND, ids));
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR, AssertExecute(FakeMethod, fake_parameters, 1));
+
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR, AssertAbort(result_parameters, 1));
+    TEST_ASSERT_EQUAL(2, fake_cleanup.called);
+    TEST_ASSERT_FALSE(AssertNotification(NULL, frame));
+
+    AssertSignalEvents(ids[0]);
+    TEST_ASSERT_EQUAL(0, fake_events->woken);
+}
+
+void test_abort_assertion_defined_but_not_executed(void) {
+    event_id_t ids[1];
+
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR, StartWithOperator(1, ASSERT_OPERATOR_AND, ids));
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR, AssertAbort(result_parameters, 1));
+    TEST_ASSERT_EQUAL(1, fake_cleanup.called);
+    TEST_ASSERT_FALSE(AssertIsDefined(NULL));
+}
+
+void test_abort_assertion_of_other_context_raise_error(void) {
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR, AssertStart(owner_parameters, 4));
+    TEST_ASSERT_EQUAL(PREAT_UNDEFINED_ERROR, AssertAbort(result_parameters, 1));
+    TEST_ASSERT_TRUE(AssertIsDefined(&links[0]));
+
+    result_frame[1] = PREAT_ASSERTIONS;
+    TEST_ASSERT_EQUAL(PREAT_PARAMETERS_ERROR, AssertAbort(result_parameters, 1));
+    result_frame[1] = 0;
 }
 
 /* === End of documentation ==================================================================== */
@@ -0,0 +1,273 @@
+/************************************************************************************************
+Copyright (c) 2022-2023, Laboratorio de Microprocesadores
+Facultad de Ciencias Exactas y Tecnología, Universidad Nacional de Tucumán
+https://www.microprocesadores.unt.edu.ar/
+
+Copyright (c) 2022-2023, Esteban Volentini <evolentini@herrera.unt.edu.ar>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Binary large objects storage unit tests
+ **
+ ** \addtogroup preat PREAT
+ ** \brief Protocol for Remote Excecution of Automated Tests
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "unity.h"
+#include "crc.h"
+#include "blob.h"
+#include "protocol.h"
+#include "assertion.h"
+#include "fake_events.h"
+#include "fake_lock.h"
+#include <string.h>
+
+/* === Macros definitions ====================================================================== */
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+static struct fake_reference_s {
+    bool called;
+    const uint8_t * data;
+    uint32_t size;
+} fake_reference;
+
+/* === Private function declarations =========================================================== */
+
+preat_error_t FakeReference(preat_parameters_t parameters, uint8_t count);
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+PREAT_METHOD(fake_reference_method, 0x7C3, false, FakeReference, PREAT_PARAMETER(0, TYPE_BLOB));
+
+// clang-format off
+static const uint8_t ACK_NO_ERROR[]          = {0x05, 0x00, 0x00, 0xa1, 0xb5};
+static const uint8_t NACK_PARAMETERS_ERROR[] = {0x07, 0x00, 0x11, 0x10, 0x03, 0xbf, 0x97};
+static const uint8_t NACK_UNDEFINED_ERROR[]  = {0x07, 0x00, 0x11, 0x10, 0x06, 0x89, 0xdc};
+static const uint8_t NACK_REDEFINED_ERROR[]  = {0x07, 0x00, 0x11, 0x10, 0x07, 0x58, 0xa9};
+static const uint8_t NACK_MEMORY_ERROR[]     = {0x07, 0x00, 0x11, 0x10, 0x08, 0x02, 0x74};
+static const uint8_t CREATE_BLOB[]           = {0x0b, 0x00, 0x22, 0x13, 0x01, 0x00, 0x00, 0x00,
+                                                0x10, 0xde, 0x8d};
+// clang-format on
+
+/* === Private function implementation ========================================================= */
+
+preat_error_t FakeReference(preat_parameters_t parameters, uint8_t count) {
+    fake_reference.called = true;
+    fake_reference.data = BlobParameter(parameters, 0, &fake_reference.size);
+    return PREAT_NO_ERROR;
+}
+
+static void PrepareCreate(uint8_t * frame, uint8_t id) {
+    crc_t crc;
+
+    memcpy(frame, CREATE_BLOB, sizeof(CREATE_BLOB));
+    frame[4] = id;
+    crc = crc_finalize(crc_update(crc_init(), frame, sizeof(CREATE_BLOB) - 2));
+    frame[sizeof(CREATE_BLOB) - 2] = (uint8_t)(crc >> 8);
+    frame[sizeof(CREATE_BLOB) - 1] = (uint8_t)(crc);
+}
+
+static void ExecuteCreate(uint8_t id) {
+    uint8_t frame[64];
+
+    PrepareCreate(frame, id);
+    PreatExecute(frame);
+    TEST_ASSERT_EQUAL_MEMORY(ACK_NO_ERROR, frame, sizeof(ACK_NO_ERROR));
+}
+
+/* === Public function implementation ========================================================= */
+
+void setUp(void) {
+    memset(&fake_reference, 0, sizeof(fake_reference));
+    BlobClean();
+    FakeEventsReset();
+    FakeLockReset();
+}
+
+void tearDown(void) {
+    TEST_ASSERT_EQUAL(0, fake_locks[PREAT_LOCK_BLOBS].depth);
+}
+
+void test_create_blob_filled_with_zeros(void) {
+    static const uint8_t EXPECTED[16] = {0};
+    uint8_t frame[64];
+    const uint8_t * data;
+    uint32_t size;
+
+    memcpy(frame, CREATE_BLOB, sizeof(CREATE_BLOB));
+    PreatExecute(frame);
+    TEST_ASSERT_EQUAL_MEMORY(ACK_NO_ERROR, frame, sizeof(ACK_NO_ERROR));
+
+    data = BlobData(0x01, &size);
+    TEST_ASSERT_NOT_NULL(data);
+    TEST_ASSERT_EQUAL(16, size);
+    TEST_ASSERT_EQUAL_MEMORY(EXPECTED, data, sizeof(EXPECTED));
+}
+
+void test_create_blob_already_defined(void) {
+    uint8_t frame[64];
+
+    ExecuteCreate(0x01);
+    memcpy(frame, CREATE_BLOB, sizeof(CREATE_BLOB));
+    PreatExecute(frame);
+    TEST_ASSERT_EQUAL_MEMORY(NACK_REDEFINED_ERROR, frame, sizeof(NACK_REDEFINED_ERROR));
+}
+
+void test_create_blob_larger_than_block(void) {
+    uint8_t frame[64] = {0x0b, 0x00, 0x22, 0x13, 0x01, 0x00, 0x00, 0x04, 0x01, 0xef, 0xb7};
+
+    PreatExecute(frame);
+    TEST_ASSERT_EQUAL_MEMORY(NACK_PARAMETERS_ERROR, frame, sizeof(NACK_PARAMETERS_ERROR));
+}
+
+void test_create_blob_without_free_blocks(void) {
+    uint8_t frame[64];
+    uint8_t id;
+
+    for (id = 1; id <= BLOB_BLOCKS_COUNT; id++) {
+        ExecuteCreate(id);
+    }
+    PrepareCreate(frame, 0x00);
+    PreatExecute(frame);
+    TEST_ASSERT_EQUAL_MEMORY(NACK_MEMORY_ERROR, frame, sizeof(NACK_MEMORY_ERROR));
+}
+
+void test_update_blob_content(void) {
+    static const uint8_t EXPECTED[] = {0x00, 0xAA, 0xBB, 0xCC, 0x00};
+    uint8_t frame[64] = {0x0d, 0x00, 0x33, 0x12, 0x01, 0x00, 0x04,
+                         0x83, 0xaa, 0xbb, 0xcc, 0x58, 0x75};
+    const uint8_t * data;
+    uint32_t size;
+
+    ExecuteCreate(0x01);
+    PreatExecute(frame);
+    TEST_ASSERT_EQUAL_MEMORY(ACK_NO_ERROR, frame, sizeof(ACK_NO_ERROR));
+
+    data = BlobData(0x01, &size);
+    TEST_ASSERT_EQUAL_MEMORY(EXPECTED, &data[3], sizeof(EXPECTED));
+}
+
+void test_update_blob_beyond_its_size(void) {
+    uint8_t frame[64] = {0x0d, 0x00, 0x33, 0x12, 0x01, 0x00, 0x0e,
+                         0x83, 0xaa, 0xbb, 0xcc, 0x28, 0xe1};
+
+    ExecuteCreate(0x01);
+    PreatExecute(frame);
+    TEST_ASSERT_EQUAL_MEMORY(NACK_PARAMETERS_ERROR, frame, sizeof(NACK_PARAMETERS_ERROR));
+}
+
+void test_update_blob_not_defined(void) {
+    uint8_t frame[64] = {0x0d, 0x00, 0x33, 0x12, 0x02, 0x00, 0x04,
+                         0x83, 0xaa, 0xbb, 0xcc, 0xd4, 0xe4};
+
+    ExecuteCreate(0x01);
+    PreatExecute(frame);
+    TEST_ASSERT_EQUAL_MEMORY(NACK_UNDEFINED_ERROR, frame, sizeof(NACK_UNDEFINED_ERROR));
+}
+
+void test_destroy_blob(void) {
+    uint8_t frame[64] = {0x07, 0x00, 0x41, 0x10, 0x01, 0xbb, 0xce};
+    uint32_t size;
+
+    ExecuteCreate(0x01);
+    PreatExecute(frame);
+    TEST_ASSERT_EQUAL_MEMORY(ACK_NO_ERROR, frame, sizeof(ACK_NO_ERROR));
+    TEST_ASSERT_NULL(BlobData(0x01, &size));
+    TEST_ASSERT_EQUAL(0, size);
+}
+
+void test_destroy_blob_not_defined(void) {
+    uint8_t frame[64] = {0x07, 0x00, 0x41, 0x10, 0x02, 0x19, 0x24};
+
+    ExecuteCreate(0x01);
+    PreatExecute(frame);
+    TEST_ASSERT_EQUAL_MEMORY(NACK_UNDEFINED_ERROR, frame, sizeof(NACK_UNDEFINED_ERROR));
+}
+
+void test_destroyed_blob_block_is_reused(void) {
+    uint8_t frame[64] = {0x07, 0x00, 0x41, 0x10, 0x01, 0xbb, 0xce};
+    uint8_t id;
+
+    for (id = 1; id <= BLOB_BLOCKS_COUNT; id++) {
+        ExecuteCreate(id);
+    }
+    PreatExecute(frame);
+    TEST_ASSERT_EQUAL_MEMORY(ACK_NO_ERROR, frame, sizeof(ACK_NO_ERROR));
+    ExecuteCreate(0x01);
+}
+
+void test_query_available_blocks(void) {
+    static const uint8_t EXPECTED[] = {0x10, 0x00, 0x03, 0x13, 0x07, 0x00, 0x00, 0x04,
+                                       0x00, 0x30, 0x00, 0x00, 0x04, 0x00, 0xd6, 0xdd};
+    uint8_t frame[64] = {0x05, 0x00, 0x70, 0x1b, 0xcb};
+
+    ExecuteCreate(0x01);
+    PreatExecute(frame);
+    TEST_ASSERT_EQUAL_MEMORY(EXPECTED, frame, sizeof(EXPECTED));
+}
+
+void test_query_blob_limit_without_free_blocks(void) {
+    static const uint8_t EXPECTED[] = {0x10, 0x00, 0x03, 0x13, 0x00, 0x00, 0x00, 0x00,
+                                       0x00, 0x30, 0x00, 0x00, 0x04, 0x00, 0x90, 0x45};
+    uint8_t frame[64] = {0x05, 0x00, 0x70, 0x1b, 0xcb};
+    uint8_t id;
+
+    for (id = 1; id <= BLOB_BLOCKS_COUNT; id++) {
+        ExecuteCreate(id);
+    }
+    PreatExecute(frame);
+    TEST_ASSERT_EQUAL_MEMORY(EXPECTED, frame, sizeof(EXPECTED));
+}
+
+void test_method_with_blob_reference(void) {
+    uint8_t frame[64] = {0x07, 0x7c, 0x31, 0x70, 0x01, 0x9e, 0x22};
+    uint32_t size;
+
+    ExecuteCreate(0x01);
+    PreatExecute(frame);
+    TEST_ASSERT_EQUAL_MEMORY(ACK_NO_ERROR, frame, sizeof(ACK_NO_ERROR));
+    TEST_ASSERT_TRUE(fake_reference.called);
+    TEST_ASSERT_EQUAL_PTR(BlobData(0x01, &size), fake_reference.data);
+    TEST_ASSERT_EQUAL(16, fake_reference.size);
+}
+
+void test_method_with_blob_reference_not_defined(void) {
+    uint8_t frame[64] = {0x07, 0x7c, 0x31, 0x70, 0x02, 0x3c, 0xc8};
+
+    ExecuteCreate(0x01);
+    PreatExecute(frame);
+    TEST_ASSERT_TRUE(fake_reference.called);
+    TEST_ASSERT_NULL(fake_reference.data);
+}
+
+void test_blob_pool_accessed_holding_its_lock(void) {
+    ExecuteCreate(0x01);
+    TEST_ASSERT_NOT_EQUAL(0, fake_locks[PREAT_LOCK_BLOBS].taken);
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
@@ -0,0 +1,129 @@
+/************************************************************************************************
+Copyright (c) 2022-2023, Laboratorio de Microprocesadores
+Facultad de Ciencias Exactas y Tecnología, Universidad Nacional de Tucumán
+https://www.microprocesadores.unt.edu.ar/
+
+Copyright (c) 2022-2023, Esteban Volentini <evolentini@herrera.unt.edu.ar>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief CRC kernels unit tests
+ **
+ ** \addtogroup preat PREAT
+ ** \brief Protocol for Remote Excecution of Automated Tests
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "unity.h"
+#include "crc.h"
+#include <string.h>
+
+/* === Macros definitions ====================================================================== */
+
+/* === Private data type declarations ========================================================== */
+
+typedef crc_t (*crc_kernel_t)(crc_t crc, const void * data, size_t data_len);
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+static uint8_t pattern[301];
+
+static const crc_kernel_t KERNELS[] = {
+    crc_update_nibble,
+    crc_update_table,
+    crc_update_slice4,
+    crc_update_slice8,
+};
+
+/* === Private function implementation ========================================================= */
+
+static crc_t ReferenceUpdate(crc_t crc, const uint8_t * data, size_t data_len) {
+    while (data_len--) {
+        crc ^= (crc_t)(*data++) << 8;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? ((crc << 1) ^ 0xD175) : (crc << 1);
+            crc &= 0xFFFF;
+        }
+    }
+    return crc;
+}
+
+/* === Public function implementation ========================================================= */
+
+void setUp(void) {
+    uint32_t seed = 0x12345678;
+
+    for (size_t index = 0; index < sizeof(pattern); index++) {
+        seed = seed * 1103515245 + 12345;
+        pattern[index] = (uint8_t)(seed >> 16);
+    }
+}
+
+void test_check_value_of_all_kernels(void) {
+    static const char CHECK[] = "123456789";
+
+    for (size_t kernel = 0; kernel < sizeof(KERNELS) / sizeof(KERNELS[0]); kernel++) {
+        crc_t crc = crc_finalize(KERNELS[kernel](crc_init(), CHECK, sizeof(CHECK) - 1));
+        TEST_ASSERT_EQUAL_HEX16(ReferenceUpdate(0, (const uint8_t *)CHECK, 9), crc);
+    }
+}
+
+void test_all_kernels_match_reference_for_every_length_and_alignment(void) {
+    crc_t expected, crc;
+
+    for (size_t offset = 0; offset < 8; offset++) {
+        for (size_t length = 0; length <= sizeof(pattern) - offset; length++) {
+            expected = ReferenceUpdate(0x1D0F, &pattern[offset], length);
+            for (size_t kernel = 0; kernel < sizeof(KERNELS) / sizeof(KERNELS[0]); kernel++) {
+                crc = KERNELS[kernel](0x1D0F, &pattern[offset], length);
+                TEST_ASSERT_EQUAL_HEX16(expected, crc);
+            }
+        }
+    }
+}
+
+void test_all_kernels_can_be_chained(void) {
+    crc_t expected = crc_update(crc_init(), pattern, sizeof(pattern));
+    crc_t crc;
+
+    for (size_t kernel = 0; kernel < sizeof(KERNELS) / sizeof(KERNELS[0]); kernel++) {
+        crc = KERNELS[kernel](crc_init(), pattern, 13);
+        crc = KERNELS[kernel](crc, &pattern[13], sizeof(pattern) - 13);
+        TEST_ASSERT_EQUAL_HEX16(expected, crc);
+    }
+}
+
+void test_frame_with_appended_crc_has_zero_remainder(void) {
+    uint8_t frame[] = {0x07, 0x00, 0x11, 0x10, 0x01, 0xcc, 0x08};
+
+    for (size_t kernel = 0; kernel < sizeof(KERNELS) / sizeof(KERNELS[0]); kernel++) {
+        TEST_ASSERT_EQUAL_HEX16(0, KERNELS[kernel](crc_init(), frame, sizeof(frame)));
+    }
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
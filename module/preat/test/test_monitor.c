@@ -0,0 +1,207 @@
+/************************************************************************************************
+Copyright (c) 2022-2023, Laboratorio de Microprocesadores
+Facultad de Ciencias Exactas y Tecnología, Universidad Nacional de Tucumán
+https://www.microprocesadores.unt.edu.ar/
+
+Copyright (c) 2022-2023, Esteban Volentini <evolentini@herrera.unt.edu.ar>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Monitor of inputs events unit tests
+ **
+ ** \addtogroup preat PREAT
+ ** \brief Protocol for Remote Excecution of Automated Tests
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "unity.h"
+#include "crc.h"
+#include "monitor.h"
+#include "protocol.h"
+#include "assertion.h"
+#include "fake_events.h"
+#include "fake_lock.h"
+#include <string.h>
+
+/* === Macros definitions ====================================================================== */
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+static uint8_t links[2];
+
+static struct fake_set_event_s {
+    uint8_t called;
+    void * context;
+} fake_set_event;
+
+/* === Private function implementation ========================================================= */
+
+static void DrainNotifications(void * context) {
+    uint8_t frame[PREAT_FRAME_MAX_LENGTH];
+
+    while (MonitorNotification(context, frame)) {
+    }
+}
+
+/* === Public function implementation ========================================================== */
+
+void MonitorSetEvent(void * context) {
+    fake_set_event.called++;
+    fake_set_event.context = context;
+}
+
+void setUp(void) {
+    MonitorStop(&links[0]);
+    MonitorStop(&links[1]);
+    memset(&fake_set_event, 0, sizeof(fake_set_event));
+    FakeEventsReset();
+    FakeLockReset();
+}
+
+void tearDown(void) {
+    TEST_ASSERT_EQUAL(0, fake_locks[PREAT_LOCK_MONITOR].depth);
+}
+
+void test_events_coalesced_in_a_notification(void) {
+    static const uint8_t EXPECTED[] = {0x14, 0x05, 0x03, 0x31, 0x00, 0x00, 0x03, 0xe8, 0x00, 0x88,
+                                       0x81, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0xfa, 0x27, 0xbb};
+    uint8_t frame[PREAT_FRAME_MAX_LENGTH];
+
+    TEST_ASSERT_TRUE(MonitorStart(&links[0]));
+    fake_events->clock = 1000;
+    MonitorRecord(1, true);
+    fake_events->clock = 1250;
+    MonitorRecord(2, false);
+
+    TEST_ASSERT_TRUE(MonitorNotification(&links[0], frame));
+    TEST_ASSERT_EQUAL_MEMORY(EXPECTED, frame, sizeof(EXPECTED));
+    TEST_ASSERT_FALSE(MonitorNotification(&links[0], frame));
+}
+
+void test_events_not_recorded_while_stopped(void) {
+    uint8_t frame[PREAT_FRAME_MAX_LENGTH];
+
+    MonitorRecord(1, true);
+    TEST_ASSERT_FALSE(MonitorNotification(&links[0], frame));
+
+    TEST_ASSERT_TRUE(MonitorStart(&links[0]));
+    TEST_ASSERT_FALSE(MonitorNotification(&links[0], frame));
+    MonitorRecord(1, true);
+    TEST_ASSERT_TRUE(MonitorStop(&links[0]));
+    TEST_ASSERT_FALSE(MonitorNotification(&links[0], frame));
+    TEST_ASSERT_EQUAL(1, fake_set_event.called);
+}
+
+void test_monitor_belongs_to_the_context_that_started_it(void) {
+    uint8_t frame[PREAT_FRAME_MAX_LENGTH];
+
+    TEST_ASSERT_TRUE(MonitorStart(&links[0]));
+    TEST_ASSERT_TRUE(MonitorStart(&links[0]));
+    TEST_ASSERT_FALSE(MonitorStart(&links[1]));
+
+    MonitorRecord(0, true);
+    TEST_ASSERT_EQUAL_PTR(&links[0], fake_set_event.context);
+    TEST_ASSERT_FALSE(MonitorNotification(&links[1], frame));
+    TEST_ASSERT_FALSE(MonitorStop(&links[1]));
+    TEST_ASSERT_TRUE(MonitorNotification(&links[0], frame));
+
+    TEST_ASSERT_TRUE(MonitorStop(&links[0]));
+    TEST_ASSERT_TRUE(MonitorStart(&links[1]));
+}
+
+void test_owner_woken_only_by_the_first_pending_event(void) {
+    TEST_ASSERT_TRUE(MonitorStart(&links[0]));
+    MonitorRecord(0, true);
+    MonitorRecord(0, false);
+    MonitorRecord(0, true);
+    TEST_ASSERT_EQUAL(1, fake_set_event.called);
+
+    DrainNotifications(&links[0]);
+    MonitorRecord(0, false);
+    TEST_ASSERT_EQUAL(2, fake_set_event.called);
+}
+
+void test_notification_limited_to_a_frame(void) {
+    uint8_t frame[PREAT_FRAME_MAX_LENGTH];
+    uint8_t index;
+
+    TEST_ASSERT_TRUE(MonitorStart(&links[0]));
+    for (index = 0; index <= MONITOR_FRAME_EVENTS; index++) {
+        fake_events->clock += 10;
+        MonitorRecord(3, (index & 1) == 0);
+    }
+
+    TEST_ASSERT_TRUE(MonitorNotification(&links[0], frame));
+    TEST_ASSERT_TRUE(PreatFrameLength(frame) <= PREAT_FRAME_MAX_LENGTH);
+    TEST_ASSERT_EQUAL_HEX8(TYPE_BINARY | (MONITOR_FRAME_EVENTS * MONITOR_EVENT_SIZE), frame[9]);
+
+    TEST_ASSERT_TRUE(MonitorNotification(&links[0], frame));
+    TEST_ASSERT_EQUAL_HEX8(TYPE_BINARY | MONITOR_EVENT_SIZE, frame[9]);
+    TEST_ASSERT_EQUAL_HEX8(MONITOR_RISSING_EDGE | 3, frame[10]);
+    TEST_ASSERT_EQUAL(10 * (MONITOR_FRAME_EVENTS + 1), ((uint32_t)frame[6] << 8) | frame[7]);
+    TEST_ASSERT_FALSE(MonitorNotification(&links[0], frame));
+}
+
+void test_notification_split_when_events_are_far_apart(void) {
+    uint8_t frame[PREAT_FRAME_MAX_LENGTH];
+
+    TEST_ASSERT_TRUE(MonitorStart(&links[0]));
+    fake_events->clock = 0xFFFFFF00;
+    MonitorRecord(0, true);
+    fake_events->clock += MONITOR_MAX_OFFSET;
+    MonitorRecord(1, true);
+    fake_events->clock += 1;
+    MonitorRecord(2, true);
+
+    TEST_ASSERT_TRUE(MonitorNotification(&links[0], frame));
+    TEST_ASSERT_EQUAL_HEX8(TYPE_BINARY | (2 * MONITOR_EVENT_SIZE), frame[9]);
+    TEST_ASSERT_EQUAL_MEMORY(((uint8_t[]){0x81, 0xFF, 0xFF, 0xFF}), &frame[14], 4);
+
+    TEST_ASSERT_TRUE(MonitorNotification(&links[0], frame));
+    TEST_ASSERT_EQUAL_HEX8(TYPE_BINARY | MONITOR_EVENT_SIZE, frame[9]);
+    TEST_ASSERT_EQUAL_HEX8(0x82, frame[10]);
+}
+
+void test_lost_events_reported_in_the_next_notification(void) {
+    uint8_t frame[PREAT_FRAME_MAX_LENGTH];
+    uint16_t index;
+
+    TEST_ASSERT_TRUE(MonitorStart(&links[0]));
+    for (index = 0; index < PREAT_MONITOR_EVENTS + 3; index++) {
+        MonitorRecord(0, true);
+    }
+
+    TEST_ASSERT_TRUE(MonitorNotification(&links[0], frame));
+    TEST_ASSERT_EQUAL(3, frame[8]);
+    TEST_ASSERT_TRUE(MonitorNotification(&links[0], frame));
+    TEST_ASSERT_EQUAL(0, frame[8]);
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
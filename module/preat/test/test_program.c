@@ -0,0 +1,312 @@
+/************************************************************************************************
+Copyright (c) 2022-2023, Laboratorio de Microprocesadores
+Facultad de Ciencias Exactas y Tecnología, Universidad Nacional de Tucumán
+https://www.microprocesadores.unt.edu.ar/
+
+Copyright (c) 2022-2023, Esteban Volentini <evolentini@herrera.unt.edu.ar>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Stored test programs engine unit tests
+ **
+ ** \addtogroup preat PREAT
+ ** \brief Protocol for Remote Excecution of Automated Tests
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "unity.h"
+#include "crc.h"
+#include "blob.h"
+#include "program.h"
+#include "protocol.h"
+#include "assertion.h"
+#include "fake_events.h"
+#include "fake_lock.h"
+#include <string.h>
+
+/* === Macros definitions ====================================================================== */
+
+#define FakeReset(var) memset(&var, 0, sizeof(var));
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+static struct fake_step_s {
+    uint8_t called;
+    uint8_t parameters[16];
+    uint8_t value;
+    uint8_t fail_on;
+    void * context;
+    int16_t lock_depth;
+} fake_step;
+
+static struct fake_delay_s {
+    uint8_t called;
+    uint32_t delay;
+} fake_delay;
+
+static uint8_t fake_destroy[PREAT_FRAME_MAX_LENGTH];
+
+/* === Private function declarations =========================================================== */
+
+preat_error_t FakeStep(preat_parameters_t parameters, uint8_t count);
+
+preat_error_t FakeDestroy(preat_parameters_t parameters, uint8_t count);
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+PREAT_METHOD(fake_step_method, 0x7E5, false, FakeStep, PREAT_SINGLE_UINT8);
+
+PREAT_METHOD(fake_destroy_method, 0x7E6, false, FakeDestroy, PREAT_SINGLE_UINT8);
+
+// clang-format off
+static const uint8_t RUN_PROGRAM[]           = {0x07, 0x04, 0x01, 0x70, 0x01, 0x26, 0xcc};
+static const uint8_t NACK_METHOD_ERROR[]     = {0x07, 0x00, 0x11, 0x10, 0x02, 0x6e, 0xe2};
+static const uint8_t NACK_UNDEFINED_ERROR[]  = {0x07, 0x00, 0x11, 0x10, 0x06, 0x89, 0xdc};
+static const uint8_t NACK_BUSY_ERROR[]       = {0x07, 0x00, 0x11, 0x10, 0x0b, 0xa0, 0x9e};
+static const uint8_t ACK_NO_ERROR[]          = {0x05, 0x00, 0x00, 0xa1, 0xb5};
+static const uint8_t DESTROY_BLOB[]          = {0x07, 0x00, 0x41, 0x10, 0x01, 0xbb, 0xce};
+// clang-format on
+
+/* === Private function implementation ========================================================= */
+
+preat_error_t FakeStep(preat_parameters_t parameters, uint8_t count) {
+    uint8_t parameter = (uint8_t)PreatParameterValue(parameters, 0);
+
+    if (fake_step.called < sizeof(fake_step.parameters)) {
+        fake_step.parameters[fake_step.called] = parameter;
+    }
+    fake_step.called++;
+    fake_step.context = PreatContext(parameters);
+    fake_step.lock_depth = fake_locks[PREAT_LOCK_PROGRAM].depth;
+    PreatResultAppend(parameters, TYPE_UINT8, fake_step.value);
+    return (parameter == fake_step.fail_on) ? PREAT_GENERIC_ERROR : PREAT_NO_ERROR;
+}
+
+preat_error_t FakeDestroy(preat_parameters_t parameters, uint8_t count) {
+    static uint8_t other_link;
+
+    /* Another server instance tries to destroy the blob while the program is running */
+    memcpy(fake_destroy, DESTROY_BLOB, sizeof(DESTROY_BLOB));
+    fake_destroy[4] = (uint8_t)PreatParameterValue(parameters, 0);
+    PreatExecuteChecked(fake_destroy, PREAT_NO_ERROR, &other_link);
+    return PREAT_NO_ERROR;
+}
+
+static void LoadProgram(const uint8_t * steps, uint16_t size) {
+    uint8_t frame[64] = {0x0b, 0x00, 0x22, 0x13, 0x01, 0x00, 0x00};
+    uint32_t capacity;
+    crc_t crc;
+
+    frame[7] = (uint8_t)(size >> 8);
+    frame[8] = (uint8_t)(size);
+    crc = crc_finalize(crc_update(crc_init(), frame, 9));
+    frame[9] = (uint8_t)(crc >> 8);
+    frame[10] = (uint8_t)(crc);
+    PreatExecute(frame);
+
+    memcpy(BlobStorage(0x01, &capacity), steps, size);
+    TEST_ASSERT_EQUAL(size, capacity);
+}
+
+static void RunProgram(uint8_t * frame) {
+    memcpy(frame, RUN_PROGRAM, sizeof(RUN_PROGRAM));
+    PreatExecute(frame);
+}
+
+/* === Public function implementation ========================================================= */
+
+void ProgramDelay(uint32_t delay) {
+    fake_delay.called++;
+    fake_delay.delay += delay;
+}
+
+void setUp(void) {
+    FakeReset(fake_step);
+    FakeReset(fake_delay);
+    fake_step.fail_on = 0xFF;
+    BlobClean();
+    FakeEventsReset();
+    FakeLockReset();
+}
+
+void tearDown(void) {
+    TEST_ASSERT_EQUAL(0, fake_locks[PREAT_LOCK_PROGRAM].depth);
+}
+
+void test_run_program_with_sequence_of_calls(void) {
+    static const uint8_t PROGRAM[] = {0x7e, 0x51, 0x10, 0x01, 0x7e, 0x51, 0x10, 0x02};
+    static const uint8_t EXPECTED[] = {0x0a, 0x00, 0x01, 0x30, 0x00, 0x00, 0x00, 0x02, 0x66, 0x82};
+    uint8_t frame[64];
+
+    LoadProgram(PROGRAM, sizeof(PROGRAM));
+    RunProgram(frame);
+    TEST_ASSERT_EQUAL(2, fake_step.called);
+    TEST_ASSERT_EQUAL(0x01, fake_step.parameters[0]);
+    TEST_ASSERT_EQUAL(0x02, fake_step.parameters[1]);
+    TEST_ASSERT_EQUAL_MEMORY(EXPECTED, frame, sizeof(EXPECTED));
+}
+
+void test_run_program_ended_before_blob_end(void) {
+    static const uint8_t PROGRAM[] = {0x7e, 0x51, 0x10, 0x01, 0x7e, 0x51, 0x10,
+                                      0x02, 0x00, 0x00, 0x00, 0x00, 0x00};
+    static const uint8_t EXPECTED[] = {0x0a, 0x00, 0x01, 0x30, 0x00, 0x00, 0x00, 0x02, 0x66, 0x82};
+    uint8_t frame[64];
+
+    LoadProgram(PROGRAM, sizeof(PROGRAM));
+    RunProgram(frame);
+    TEST_ASSERT_EQUAL(2, fake_step.called);
+    TEST_ASSERT_EQUAL_MEMORY(EXPECTED, frame, sizeof(EXPECTED));
+}
+
+void test_run_program_with_delay(void) {
+    static const uint8_t PROGRAM[] = {0x7e, 0x51, 0x10, 0x01, 0x04, 0x11,
+                                      0x30, 0x00, 0x00, 0x00, 0x05};
+    static const uint8_t EXPECTED[] = {0x0a, 0x00, 0x01, 0x30, 0x00, 0x00, 0x00, 0x02, 0x66, 0x82};
+    uint8_t frame[64];
+
+    LoadProgram(PROGRAM, sizeof(PROGRAM));
+    RunProgram(frame);
+    TEST_ASSERT_EQUAL(1, fake_delay.called);
+    TEST_ASSERT_EQUAL(5, fake_delay.delay);
+    TEST_ASSERT_EQUAL_MEMORY(EXPECTED, frame, sizeof(EXPECTED));
+}
+
+void test_run_program_with_loop(void) {
+    static const uint8_t PROGRAM[] = {0x7e, 0x51, 0x10, 0x07, 0x04, 0x22, 0x12, 0x00, 0x00, 0x03};
+    static const uint8_t EXPECTED[] = {0x0a, 0x00, 0x01, 0x30, 0x00, 0x00, 0x00, 0x08, 0x0a, 0x14};
+    uint8_t frame[64];
+
+    LoadProgram(PROGRAM, sizeof(PROGRAM));
+    RunProgram(frame);
+    TEST_ASSERT_EQUAL(4, fake_step.called);
+    TEST_ASSERT_EQUAL_MEMORY(EXPECTED, frame, sizeof(EXPECTED));
+}
+
+void test_run_program_with_branch_taken(void) {
+    static const uint8_t PROGRAM[] = {0x7e, 0x51, 0x10, 0x01, 0x04, 0x32, 0x31, 0x00,
+                                      0x00, 0x00, 0x01, 0x03, 0x7e, 0x51, 0x10, 0x02,
+                                      0x7e, 0x51, 0x10, 0x03};
+    static const uint8_t EXPECTED[] = {0x0a, 0x00, 0x01, 0x30, 0x00, 0x00, 0x00, 0x03, 0xb7, 0xf7};
+    uint8_t frame[64];
+
+    fake_step.value = 0x01;
+    LoadProgram(PROGRAM, sizeof(PROGRAM));
+    RunProgram(frame);
+    TEST_ASSERT_EQUAL(2, fake_step.called);
+    TEST_ASSERT_EQUAL(0x01, fake_step.parameters[0]);
+    TEST_ASSERT_EQUAL(0x03, fake_step.parameters[1]);
+    TEST_ASSERT_EQUAL_MEMORY(EXPECTED, frame, sizeof(EXPECTED));
+}
+
+void test_run_program_with_branch_not_taken(void) {
+    static const uint8_t PROGRAM[] = {0x7e, 0x51, 0x10, 0x01, 0x04, 0x32, 0x31, 0x00,
+                                      0x00, 0x00, 0x01, 0x03, 0x7e, 0x51, 0x10, 0x02,
+                                      0x7e, 0x51, 0x10, 0x03};
+    static const uint8_t EXPECTED[] = {0x0a, 0x00, 0x01, 0x30, 0x00, 0x00, 0x00, 0x04, 0xf2, 0x23};
+    uint8_t frame[64];
+
+    LoadProgram(PROGRAM, sizeof(PROGRAM));
+    RunProgram(frame);
+    TEST_ASSERT_EQUAL(3, fake_step.called);
+    TEST_ASSERT_EQUAL_MEMORY(EXPECTED, frame, sizeof(EXPECTED));
+}
+
+void test_run_program_with_endless_branch(void) {
+    static const uint8_t PROGRAM[] = {0x7e, 0x51, 0x10, 0x01, 0x04, 0x32,
+                                      0x31, 0x00, 0x00, 0x00, 0x00, 0x00};
+    static const uint8_t EXPECTED[] = {0x08, 0x00, 0x12, 0x11, 0x05, 0x00, 0x49, 0x48};
+    uint8_t frame[64];
+
+    LoadProgram(PROGRAM, sizeof(PROGRAM));
+    RunProgram(frame);
+    TEST_ASSERT_EQUAL_MEMORY(EXPECTED, frame, sizeof(EXPECTED));
+}
+
+void test_run_program_with_failed_step(void) {
+    static const uint8_t PROGRAM[] = {0x7e, 0x51, 0x10, 0x01, 0x7e, 0x51,
+                                      0x10, 0x02, 0x7e, 0x51, 0x10, 0x03};
+    static const uint8_t EXPECTED[] = {0x08, 0x00, 0x12, 0x11, 0xff, 0x01, 0x4b, 0x72};
+    uint8_t frame[64];
+
+    fake_step.fail_on = 0x02;
+    LoadProgram(PROGRAM, sizeof(PROGRAM));
+    RunProgram(frame);
+    TEST_ASSERT_EQUAL(2, fake_step.called);
+    TEST_ASSERT_EQUAL_MEMORY(EXPECTED, frame, sizeof(EXPECTED));
+}
+
+void test_run_program_with_invalid_step(void) {
+    static const uint8_t PROGRAM[] = {0x7e, 0x51, 0x10, 0x01, 0x7e, 0x51, 0x10};
+    static const uint8_t EXPECTED[] = {0x08, 0x00, 0x12, 0x11, 0x03, 0x01, 0xc1, 0xf4};
+    uint8_t frame[64];
+
+    LoadProgram(PROGRAM, sizeof(PROGRAM));
+    RunProgram(frame);
+    TEST_ASSERT_EQUAL(0, fake_step.called);
+    TEST_ASSERT_EQUAL_MEMORY(EXPECTED, frame, sizeof(EXPECTED));
+}
+
+void test_run_program_not_defined(void) {
+    uint8_t frame[64];
+
+    RunProgram(frame);
+    TEST_ASSERT_EQUAL_MEMORY(NACK_UNDEFINED_ERROR, frame, sizeof(NACK_UNDEFINED_ERROR));
+}
+
+void test_loop_outside_program(void) {
+    uint8_t frame[64] = {0x09, 0x04, 0x22, 0x12, 0x00, 0x00, 0x03, 0xc0, 0xe0};
+
+    PreatExecute(frame);
+    TEST_ASSERT_EQUAL_MEMORY(NACK_METHOD_ERROR, frame, sizeof(NACK_METHOD_ERROR));
+}
+
+void test_program_steps_run_in_the_caller_context(void) {
+    static const uint8_t PROGRAM[] = {0x7e, 0x51, 0x10, 0x01};
+    static uint8_t link;
+    uint8_t frame[64];
+
+    LoadProgram(PROGRAM, sizeof(PROGRAM));
+    memcpy(frame, RUN_PROGRAM, sizeof(RUN_PROGRAM));
+    PreatExecuteChecked(frame, PREAT_NO_ERROR, &link);
+    TEST_ASSERT_EQUAL(1, fake_step.called);
+    TEST_ASSERT_EQUAL_PTR(&link, fake_step.context);
+    TEST_ASSERT_EQUAL(1, fake_step.lock_depth);
+}
+
+void test_program_blob_not_destroyed_while_it_runs(void) {
+    static const uint8_t PROGRAM[] = {0x7e, 0x61, 0x10, 0x01};
+    uint8_t frame[64];
+
+    LoadProgram(PROGRAM, sizeof(PROGRAM));
+    RunProgram(frame);
+    TEST_ASSERT_EQUAL_MEMORY(NACK_BUSY_ERROR, fake_destroy, sizeof(NACK_BUSY_ERROR));
+
+    memcpy(frame, DESTROY_BLOB, sizeof(DESTROY_BLOB));
+    PreatExecute(frame);
+    TEST_ASSERT_EQUAL_MEMORY(ACK_NO_ERROR, frame, sizeof(ACK_NO_ERROR));
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
@@ -35,6 +35,8 @@ SPDX-License-Identifier: MIT
 #include "crc.h"
 #include "protocol.h"
 #include "assertion.h"
+#include "fake_events.h"
+#include "fake_lock.h"
 #include <string.h>
 
 /* === Macros definitions ====================================================================== */
@@ -52,6 +54,7 @@ struct input_state_s {
 static struct fake_cleanup_s {
     bool called;
     input_state_t state;
+    event_id_t id;
 } fake_cleanup;
 
 static struct fake_input_s {
@@ -66,74 +69,100 @@ static struct fake_output_s {
     bool called;
     uint8_t parameter;
     uint8_t count;
+    void * context;
     preat_error_t result;
 } fake_output;
 
-static struct fake_events_s {
-    uint8_t called;
-    struct events_call_s {
-        event_flags_t events;
-        uint32_t timeout;
-        bool wait_for_all;
-        event_flags_t result;
-    } calls[8];
-} fake_events;
+static struct fake_binary_s {
+    bool called;
+    preat_slice_t slice;
+    uint8_t value[8];
+    uint8_t parameter;
+} fake_binary;
+
+static uint16_t fake_conflict;
 
 /* === Private function declarations =========================================================== */
 
-preat_error_t FakeInput(const preat_parameter_t parameters, uint8_t count);
+preat_error_t FakeInput(preat_parameters_t parameters, uint8_t count);
+
+preat_error_t FakeOutput(preat_parameters_t parameters, uint8_t count);
 
-preat_error_t FakeOutput(const preat_parameter_t parameters, uint8_t count);
+preat_error_t FakeBinary(preat_parameters_t parameters, uint8_t count);
+
+preat_error_t FakeTrailingBinary(preat_parameters_t parameters, uint8_t count);
 
 /* === Public variable definitions ============================================================= */
 
 /* === Private variable definitions ============================================================ */
 
+PREAT_METHOD(fake_static_output, 0x7B2, true, FakeOutput, PREAT_SINGLE_UINT8);
+
+PREAT_METHOD(fake_binary_method, 0x7D4, false, FakeBinary,
+             PREAT_PARAMETER(0, TYPE_BINARY) | PREAT_PARAMETER(1, TYPE_UINT8));
+
+PREAT_METHOD(fake_trailing_binary_method, 0x7D5, false, FakeTrailingBinary,
+             PREAT_PARAMETER(0, TYPE_UINT8) | PREAT_PARAMETER(1, TYPE_BINARY));
+
+PREAT_METHOD(fake_first_method, 0x7D6, false, FakeOutput, PREAT_SINGLE_UINT8);
+
+PREAT_METHOD(fake_duplicated_method, 0x7D6, false, FakeOutput, PREAT_SINGLE_UINT8);
+
 // clang-format off
 static const uint8_t ACK_NO_ERROR[]          = {0x05, 0x00, 0x00, 0xa1, 0xb5};
 static const uint8_t NACK_CRC_ERROR[]        = {0x07, 0x00, 0x11, 0x10, 0x01, 0xcc, 0x08};
 static const uint8_t NACK_METHOD_ERROR[]     = {0x07, 0x00, 0x11, 0x10, 0x02, 0x6e, 0xe2};
 static const uint8_t NACK_PARAMETERS_ERROR[] = {0x07, 0x00, 0x11, 0x10, 0x03, 0xbf, 0x97};
-static const uint8_t NACK_TIMEOUT_ERROR[]    = {0x07, 0x00, 0x11, 0x10, 0x05, 0x2b, 0x36};
+static const uint8_t NACK_TIMEOUT_ERROR[]    = {0x08, 0x00, 0x12, 0x11, 0x05, 0x00, 0x49, 0x48};
+static const uint8_t ACK_ASSERT_HANDLE[]     = {0x07, 0x00, 0x01, 0x10, 0x00, 0xd9, 0x21};
+static const uint8_t NACK_BATCH_METHOD[]     = {0x08, 0x00, 0x12, 0x11, 0x02, 0x01, 0x82, 0x3e};
+static const uint8_t NACK_BATCH_PARAMETERS[] = {0x08, 0x00, 0x12, 0x11, 0x03, 0x01, 0xc1, 0xf4};
+static const uint8_t NACK_BATCH_TIMEOUT[]    = {0x08, 0x00, 0x12, 0x11, 0x05, 0x02, 0x3a, 0xd7};
 // clang-format on
 
 /* === Private function implementation ========================================================= */
 
-void FakeCleanup(input_state_t state) {
+void FakeCleanup(input_state_t state, event_id_t id) {
     fake_cleanup.called = true;
     fake_cleanup.state = state;
+    fake_cleanup.id = id;
 }
 
-preat_error_t FakeInput(const preat_parameter_t parameters, uint8_t count) {
+preat_error_t FakeInput(preat_parameters_t parameters, uint8_t count) {
     fake_input.called = true;
-    fake_input.parameter = (uint8_t)parameters[0].value;
+    fake_input.parameter = (uint8_t)PreatParameterValue(parameters, 0);
     fake_input.count = count;
-    fake_input.event_id = AssertRegisterEvent(FakeCleanup, &fake_state);
+    fake_input.event_id = AssertRegisterEvent(PreatContext(parameters), FakeCleanup, &fake_state);
     return fake_input.result;
 }
 
-preat_error_t FakeOutput(const preat_parameter_t parameters, uint8_t count) {
+preat_error_t FakeOutput(preat_parameters_t parameters, uint8_t count) {
     fake_output.called = true;
-    fake_output.parameter = (uint8_t)parameters[0].value;
+    fake_output.parameter = (uint8_t)PreatParameterValue(parameters, 0);
     fake_output.count = count;
+    fake_output.context = PreatContext(parameters);
     return fake_output.result;
 }
 
-/* === Public function implementation ========================================================= */
+preat_error_t FakeBinary(preat_parameters_t parameters, uint8_t count) {
+    fake_binary.called = true;
+    fake_binary.slice = PreatParameterSlice(parameters, 0);
+    memcpy(fake_binary.value, fake_binary.slice.data, fake_binary.slice.length);
+    fake_binary.parameter = (uint8_t)PreatParameterValue(parameters, 1);
+    return PREAT_NO_ERROR;
+}
+
+preat_error_t FakeTrailingBinary(preat_parameters_t parameters, uint8_t count) {
+    fake_binary.called = true;
+    fake_binary.parameter = (uint8_t)PreatParameterValue(parameters, 0);
+    fake_binary.slice = PreatParameterSlice(parameters, 1);
+    return PREAT_NO_ERROR;
+}
 
-event_flags_t AssertWaitEvents(event_flags_t events, uint32_t timeout, bool wait_for_all) {
-    event_flags_t result = 0;
+/* === Public function implementation ========================================================= */
 
-    if (fake_events.called < sizeof(fake_events.calls) / sizeof(fake_events.calls[0]) - 1) {
-        fake_events.calls[fake_events.called].events = events;
-        fake_events.calls[fake_events.called].timeout = timeout;
-        fake_events.calls[fake_events.called].wait_for_all = wait_for_all;
-        result = fake_events.calls[fake_events.called].result;
-        fake_events.called++;
-    } else {
-        TEST_FAIL_MESSAGE("No more space to save calls");
-    }
-    return result;
+void PreatMethodConflict(uint16_t id) {
+    fake_conflict = id;
 }
 
 void suiteSetUp(void) {
@@ -144,8 +173,10 @@ void suiteSetUp(void) {
 void setUp(void) {
     FakeReset(fake_input);
     FakeReset(fake_output);
-    FakeReset(fake_events);
     FakeReset(fake_cleanup);
+    FakeEventsReset();
+    FakeReset(fake_binary);
+    FakeLockReset();
 }
 
 void test_frame_has_crc_error(void) {
@@ -176,6 +207,61 @@ void test_execute_funcion_with_more_parameters(void) {
     TEST_ASSERT_EQUAL_MEMORY(NACK_PARAMETERS_ERROR, frame, sizeof(NACK_PARAMETERS_ERROR));
 }
 
+void test_execute_funcion_with_less_parameters_values(void) {
+    uint8_t frame[64] = {0x07, 0x01, 0x02, 0x11, 0x01, 0x96, 0xfa};
+
+    PreatExecute(frame);
+    TEST_ASSERT_FALSE(fake_output.called);
+    TEST_ASSERT_EQUAL_MEMORY(NACK_PARAMETERS_ERROR, frame, sizeof(NACK_PARAMETERS_ERROR));
+}
+
+void test_execute_funcion_with_more_parameters_values(void) {
+    uint8_t frame[64] = {0x08, 0x01, 0x01, 0x10, 0x01, 0x02, 0xbc, 0x46};
+
+    PreatExecute(frame);
+    TEST_ASSERT_FALSE(fake_output.called);
+    TEST_ASSERT_EQUAL_MEMORY(NACK_PARAMETERS_ERROR, frame, sizeof(NACK_PARAMETERS_ERROR));
+}
+
+void test_frame_with_invalid_length(void) {
+    uint8_t frame[64] = {0x03, 0x01, 0x01};
+
+    PreatExecute(frame);
+    TEST_ASSERT_EQUAL_MEMORY(NACK_CRC_ERROR, frame, sizeof(NACK_CRC_ERROR));
+}
+
+void test_execute_frame_verified_by_transport(void) {
+    uint8_t frame[64] = {0x07, 0x01, 0x01, 0x10, 0x01, 0x00, 0x00};
+
+    PreatExecuteChecked(frame, PREAT_NO_ERROR, NULL);
+    TEST_ASSERT_TRUE(fake_output.called);
+    TEST_ASSERT_EQUAL_MEMORY(ACK_NO_ERROR, frame, sizeof(ACK_NO_ERROR));
+}
+
+void test_execute_frame_rejected_by_transport(void) {
+    uint8_t frame[64] = {0x07, 0x01, 0x01, 0x10, 0x01, 0xb5, 0x00};
+
+    PreatExecuteChecked(frame, PREAT_CRC_ERROR, NULL);
+    TEST_ASSERT_FALSE(fake_output.called);
+    TEST_ASSERT_EQUAL_MEMORY(NACK_CRC_ERROR, frame, sizeof(NACK_CRC_ERROR));
+}
+
+void test_frame_dropped_by_transport(void) {
+    static const uint8_t NACK_SEQUENCED[] = {0x88, 0x2a, 0x00, 0x11, 0x10, 0x09, 0xd5, 0xe9};
+    uint8_t frame[64] = {0x89, 0x2a, 0x01, 0x02, 0x11};
+
+    PreatExecuteChecked(frame, PREAT_FRAMING_ERROR, NULL);
+    TEST_ASSERT_FALSE(fake_output.called);
+    TEST_ASSERT_EQUAL_MEMORY(NACK_SEQUENCED, frame, sizeof(NACK_SEQUENCED));
+}
+
+void test_verified_frame_with_invalid_length(void) {
+    uint8_t frame[64] = {0x03, 0x01, 0x01};
+
+    PreatExecuteChecked(frame, PREAT_NO_ERROR, NULL);
+    TEST_ASSERT_EQUAL_MEMORY(NACK_CRC_ERROR, frame, sizeof(NACK_CRC_ERROR));
+}
+
 void test_execute_single_parameter_funcion(void) {
     uint8_t frame[] = {0x07, 0x01, 0x01, 0x10, 0x01, 0xb5, 0xa3};
 
@@ -189,6 +275,43 @@ void test_execute_single_parameter_funcion(void) {
     TEST_ASSERT_EQUAL_MEMORY(ACK_NO_ERROR, frame, sizeof(ACK_NO_ERROR));
 }
 
+void test_register_method_with_duplicated_id(void) {
+    TEST_ASSERT_FALSE(PreatRegister(0x10, true, FakeOutput, SINGLE_UINT8_PARAM));
+    TEST_ASSERT_FALSE(PreatRegister(0x05, true, FakeOutput, SINGLE_UINT8_PARAM));
+}
+
+void test_execute_method_registered_in_other_page(void) {
+    uint8_t frame[64] = {0x07, 0x7a, 0x11, 0x10, 0x02, 0xe1, 0x06};
+
+    TEST_ASSERT_TRUE(PreatRegister(0x7A1, true, FakeOutput, SINGLE_UINT8_PARAM));
+    fake_output.result = PREAT_NO_ERROR;
+
+    PreatExecute(frame);
+    TEST_ASSERT_TRUE(fake_output.called);
+    TEST_ASSERT_EQUAL(0x02, fake_output.parameter);
+    TEST_ASSERT_EQUAL_MEMORY(ACK_NO_ERROR, frame, sizeof(ACK_NO_ERROR));
+}
+
+void test_execute_method_declared_at_compile_time(void) {
+    uint8_t frame[64] = {0x07, 0x7b, 0x21, 0x10, 0x04, 0x55, 0xc1};
+
+    fake_output.result = PREAT_NO_ERROR;
+
+    PreatExecute(frame);
+    TEST_ASSERT_TRUE(fake_output.called);
+    TEST_ASSERT_EQUAL(0x04, fake_output.parameter);
+    TEST_ASSERT_EQUAL_MEMORY(ACK_NO_ERROR, frame, sizeof(ACK_NO_ERROR));
+}
+
+void test_register_method_declared_at_compile_time(void) {
+    TEST_ASSERT_FALSE(PreatRegister(0x7B2, true, FakeOutput, SINGLE_UINT8_PARAM));
+}
+
+void test_static_method_declared_twice_is_reported(void) {
+    TEST_ASSERT_EQUAL(1, PreatMethodConflicts());
+    TEST_ASSERT_EQUAL_HEX16(0x7D6, fake_conflict);
+}
+
 void test_execute_assert_single_condition_without_error(void) {
     uint8_t frames[3][17] = {
         {0x11, 0x00, 0x54, 0x33, 0x00, 0x00, 0x00, 0x64, 0x00, 0x00, 0x13, 0x88, 0x11, 0x01, 0x00,
@@ -198,12 +321,13 @@ void test_execute_assert_single_condition_without_error(void) {
     };
 
     PreatExecute(frames[0]);
-    TEST_ASSERT_EQUAL_MEMORY(ACK_NO_ERROR, frames[0], sizeof(ACK_NO_ERROR));
+    TEST_ASSERT_EQUAL_MEMORY(ACK_ASSERT_HANDLE, frames[0], sizeof(ACK_ASSERT_HANDLE));
 
     PreatExecute(frames[1]);
     TEST_ASSERT_EQUAL_MEMORY(ACK_NO_ERROR, frames[1], sizeof(ACK_NO_ERROR));
 
-    fake_events.calls[1].result = fake_input.event_id;
+    fake_events->calls[1].result = fake_input.event_id;
+    fake_events->calls[1].elapsed = 200 * 1000;
     PreatExecute(frames[2]);
     TEST_ASSERT_EQUAL_MEMORY(ACK_NO_ERROR, frames[2], sizeof(ACK_NO_ERROR));
 
@@ -215,16 +339,52 @@ void test_execute_assert_single_condition_without_error(void) {
     TEST_ASSERT_EQUAL(3, fake_input.parameter);
     TEST_ASSERT_EQUAL(1, fake_input.count);
 
-    TEST_ASSERT_EQUAL(2, fake_events.called);
-    TEST_ASSERT_EQUAL(100, fake_events.calls[0].timeout);
-    TEST_ASSERT_FALSE(fake_events.calls[0].wait_for_all);
-    TEST_ASSERT_EQUAL(5000, fake_events.calls[1].timeout);
-    TEST_ASSERT_TRUE(fake_events.calls[1].wait_for_all);
+    TEST_ASSERT_EQUAL(2, fake_events->called);
+    TEST_ASSERT_EQUAL(5100, fake_events->calls[1].timeout);
 
     TEST_ASSERT_TRUE(fake_cleanup.called);
     TEST_ASSERT_EQUAL(&fake_state, fake_cleanup.state);
 }
 
+void test_query_the_times_of_an_executed_assert(void) {
+    static const uint8_t ACK_RESULT[] = {
+        0x0d, 0x00, 0x03, 0x11, 0x01, 0x01, 0x84, 0x00, 0x03, 0x0d, 0x40, 0x71, 0x3d,
+    };
+    uint8_t frames[4][17] = {
+        {0x11, 0x00, 0x54, 0x33, 0x00, 0x00, 0x00, 0x64, 0x00, 0x00, 0x13, 0x88, 0x11, 0x01, 0x00,
+         0xcd, 0x2c},
+        {0x07, 0x01, 0x51, 0x10, 0x03, 0xB1, 0xFA},
+        {0x07, 0x01, 0x01, 0x10, 0x01, 0xb5, 0xa3},
+        {0x07, 0x00, 0x91, 0x10, 0x00, 0xab, 0x3c},
+    };
+
+    PreatExecute(frames[0]);
+    PreatExecute(frames[1]);
+    fake_events->calls[1].result = fake_input.event_id;
+    fake_events->calls[1].elapsed = 200 * 1000;
+    PreatExecute(frames[2]);
+    TEST_ASSERT_EQUAL_MEMORY(ACK_NO_ERROR, frames[2], sizeof(ACK_NO_ERROR));
+
+    PreatExecute(frames[3]);
+    TEST_ASSERT_EQUAL_MEMORY(ACK_RESULT, frames[3], sizeof(ACK_RESULT));
+}
+
+void test_abort_an_assert_not_executed(void) {
+    uint8_t frames[3][17] = {
+        {0x11, 0x00, 0x54, 0x33, 0x00, 0x00, 0x00, 0x64, 0x00, 0x00, 0x13, 0x88, 0x11, 0x01, 0x00,
+         0xcd, 0x2c},
+        {0x07, 0x01, 0x51, 0x10, 0x03, 0xB1, 0xFA},
+        {0x07, 0x00, 0xa1, 0x10, 0x00, 0x36, 0xad},
+    };
+
+    PreatExecute(frames[0]);
+    PreatExecute(frames[1]);
+    PreatExecute(frames[2]);
+    TEST_ASSERT_EQUAL_MEMORY(ACK_NO_ERROR, frames[2], sizeof(ACK_NO_ERROR));
+    TEST_ASSERT_TRUE(fake_cleanup.called);
+    TEST_ASSERT_FALSE(AssertIsDefined(NULL));
+}
+
 void test_execute_assert_single_condition_with_timeout(void) {
     uint8_t frames[3][17] = {
         {0x11, 0x00, 0x54, 0x33, 0x00, 0x00, 0x00, 0x64, 0x00, 0x00, 0x13, 0x88, 0x11, 0x01, 0x00,
@@ -234,7 +394,7 @@ void test_execute_assert_single_condition_with_timeout(void) {
     };
 
     PreatExecute(frames[0]);
-    TEST_ASSERT_EQUAL_MEMORY(ACK_NO_ERROR, frames[0], sizeof(ACK_NO_ERROR));
+    TEST_ASSERT_EQUAL_MEMORY(ACK_ASSERT_HANDLE, frames[0], sizeof(ACK_ASSERT_HANDLE));
 
     PreatExecute(frames[1]);
     TEST_ASSERT_EQUAL_MEMORY(ACK_NO_ERROR, frames[1], sizeof(ACK_NO_ERROR));
@@ -250,16 +410,227 @@ void test_execute_assert_single_condition_with_timeout(void) {
     TEST_ASSERT_EQUAL(3, fake_input.parameter);
     TEST_ASSERT_EQUAL(1, fake_input.count);
 
-    TEST_ASSERT_EQUAL(2, fake_events.called);
-    TEST_ASSERT_EQUAL(100, fake_events.calls[0].timeout);
-    TEST_ASSERT_FALSE(fake_events.calls[0].wait_for_all);
-    TEST_ASSERT_EQUAL(5000, fake_events.calls[1].timeout);
-    TEST_ASSERT_TRUE(fake_events.calls[1].wait_for_all);
+    TEST_ASSERT_EQUAL(3, fake_events->called);
+    TEST_ASSERT_EQUAL(5100, fake_events->calls[1].timeout);
+    TEST_ASSERT_EQUAL(0, fake_events->calls[2].timeout);
 
     TEST_ASSERT_TRUE(fake_cleanup.called);
     TEST_ASSERT_EQUAL(&fake_state, fake_cleanup.state);
 }
 
+void test_assert_belongs_to_the_context_that_started_it(void) {
+    static uint8_t links[2];
+    uint8_t frames[4][17] = {
+        {0x11, 0x00, 0x54, 0x33, 0x00, 0x00, 0x00, 0x64, 0x00, 0x00, 0x13, 0x88, 0x11, 0x01, 0x00,
+         0xcd, 0x2c},
+        {0x07, 0x01, 0x51, 0x10, 0x03, 0xB1, 0xFA},
+        {0x07, 0x01, 0x01, 0x10, 0x01, 0xb5, 0xa3},
+        {0x07, 0x01, 0x01, 0x10, 0x01, 0xb5, 0xa3},
+    };
+
+    PreatExecuteChecked(frames[0], PREAT_NO_ERROR, &links[0]);
+    TEST_ASSERT_EQUAL_MEMORY(ACK_ASSERT_HANDLE, frames[0], sizeof(ACK_ASSERT_HANDLE));
+
+    PreatExecuteChecked(frames[1], PREAT_NO_ERROR, &links[0]);
+    TEST_ASSERT_EQUAL_MEMORY(ACK_NO_ERROR, frames[1], sizeof(ACK_NO_ERROR));
+
+    PreatExecuteChecked(frames[2], PREAT_NO_ERROR, &links[1]);
+    TEST_ASSERT_EQUAL_MEMORY(ACK_NO_ERROR, frames[2], sizeof(ACK_NO_ERROR));
+    TEST_ASSERT_EQUAL(&links[1], fake_output.context);
+    TEST_ASSERT_EQUAL(0, fake_events->called);
+    TEST_ASSERT_FALSE(fake_cleanup.called);
+
+    fake_events->calls[1].result = fake_input.event_id;
+    fake_events->calls[1].elapsed = 200 * 1000;
+    PreatExecuteChecked(frames[3], PREAT_NO_ERROR, &links[0]);
+    TEST_ASSERT_EQUAL_MEMORY(ACK_NO_ERROR, frames[3], sizeof(ACK_NO_ERROR));
+    TEST_ASSERT_EQUAL(&links[0], fake_output.context);
+    TEST_ASSERT_EQUAL(2, fake_events->called);
+    TEST_ASSERT_TRUE(fake_cleanup.called);
+    TEST_ASSERT_EQUAL(0, fake_locks[PREAT_LOCK_ASSERTION].depth);
+}
+
+void test_input_of_other_context_rejected_while_assert_is_defined(void) {
+    static uint8_t links[2];
+    uint8_t frames[3][17] = {
+        {0x11, 0x00, 0x54, 0x33, 0x00, 0x00, 0x00, 0x64, 0x00, 0x00, 0x13, 0x88, 0x11, 0x01, 0x00,
+         0xcd, 0x2c},
+        {0x07, 0x01, 0x51, 0x10, 0x03, 0xB1, 0xFA},
+        {0x07, 0x01, 0x01, 0x10, 0x01, 0xb5, 0xa3},
+    };
+
+    PreatExecuteChecked(frames[0], PREAT_NO_ERROR, &links[0]);
+    PreatExecuteChecked(frames[1], PREAT_NO_ERROR, &links[1]);
+    TEST_ASSERT_TRUE(fake_input.called);
+    TEST_ASSERT_EQUAL(ASSERT_EVENT_INVALID_ID, fake_input.event_id);
+
+    AssertClean();
+    TEST_ASSERT_EQUAL(0, fake_locks[PREAT_LOCK_ASSERTION].depth);
+}
+
+void test_execute_batch_of_outputs(void) {
+    uint8_t frame[64] = {0x0d, 0x00, 0x60, 0x01, 0x01, 0x10, 0x01,
+                         0x01, 0x01, 0x10, 0x02, 0x45, 0xdb};
+
+    fake_output.result = PREAT_NO_ERROR;
+
+    PreatExecute(frame);
+    TEST_ASSERT_TRUE(fake_output.called);
+    TEST_ASSERT_EQUAL(0x02, fake_output.parameter);
+    TEST_ASSERT_EQUAL_MEMORY(ACK_NO_ERROR, frame, sizeof(ACK_NO_ERROR));
+}
+
+void test_execute_batch_with_undefined_method(void) {
+    uint8_t frame[64] = {0x0d, 0x00, 0x60, 0x01, 0x01, 0x10, 0x01,
+                         0x02, 0x01, 0x10, 0x01, 0xf0, 0x5d};
+
+    fake_output.result = PREAT_NO_ERROR;
+
+    PreatExecute(frame);
+    TEST_ASSERT_TRUE(fake_output.called);
+    TEST_ASSERT_EQUAL_MEMORY(NACK_BATCH_METHOD, frame, sizeof(NACK_BATCH_METHOD));
+}
+
+void test_execute_batch_with_truncated_call(void) {
+    uint8_t frame[64] = {0x0c, 0x00, 0x60, 0x01, 0x01, 0x10, 0x01, 0x01, 0x02, 0x11, 0x30, 0x50};
+
+    fake_output.result = PREAT_NO_ERROR;
+
+    PreatExecute(frame);
+    TEST_ASSERT_EQUAL_MEMORY(NACK_BATCH_PARAMETERS, frame, sizeof(NACK_BATCH_PARAMETERS));
+}
+
+void test_execute_batch_with_assert_single_condition(void) {
+    uint8_t frame[64] = {0x1b, 0x00, 0x60, 0x00, 0x54, 0x33, 0x00, 0x00, 0x00, 0x64,
+                         0x00, 0x00, 0x13, 0x88, 0x11, 0x01, 0x00, 0x01, 0x51, 0x10,
+                         0x03, 0x01, 0x01, 0x10, 0x01, 0x24, 0xc1};
+
+    PreatExecute(frame);
+    TEST_ASSERT_EQUAL_MEMORY(NACK_BATCH_TIMEOUT, frame, sizeof(NACK_BATCH_TIMEOUT));
+
+    TEST_ASSERT_TRUE(fake_output.called);
+    TEST_ASSERT_TRUE(fake_input.called);
+    TEST_ASSERT_EQUAL(3, fake_input.parameter);
+    TEST_ASSERT_EQUAL(3, fake_events->called);
+    TEST_ASSERT_TRUE(fake_cleanup.called);
+}
+
+void test_execute_sequenced_frame(void) {
+    static const uint8_t ACK_SEQUENCED[] = {0x86, 0x2a, 0x00, 0x00, 0x53, 0x78};
+    uint8_t frame[64] = {0x88, 0x2a, 0x01, 0x01, 0x10, 0x01, 0xb3, 0x4b};
+
+    fake_output.result = PREAT_NO_ERROR;
+
+    PreatExecute(frame);
+    TEST_ASSERT_TRUE(fake_output.called);
+    TEST_ASSERT_EQUAL(0x01, fake_output.parameter);
+    TEST_ASSERT_EQUAL_MEMORY(ACK_SEQUENCED, frame, sizeof(ACK_SEQUENCED));
+}
+
+void test_query_pipeline_window(void) {
+    static const uint8_t ACK_WINDOW[] = {0x88, 0x07, 0x00, 0x01, 0x10, 0x04, 0x13, 0x98};
+    uint8_t frame[64] = {0x86, 0x07, 0x03, 0x00, 0x0d, 0x70};
+
+    PreatExecute(frame);
+    TEST_ASSERT_EQUAL_MEMORY(ACK_WINDOW, frame, sizeof(ACK_WINDOW));
+}
+
+void test_execute_extended_frame(void) {
+    static const uint8_t ACK_EXTENDED[] = {0x00, 0x00, 0x07, 0x00, 0x00, 0x51, 0x84};
+    uint8_t frame[64] = {0x00, 0x00, 0x09, 0x01, 0x01, 0x10, 0x02, 0xe2, 0x06};
+
+    fake_output.result = PREAT_NO_ERROR;
+
+    PreatExecute(frame);
+    TEST_ASSERT_TRUE(fake_output.called);
+    TEST_ASSERT_EQUAL(0x02, fake_output.parameter);
+    TEST_ASSERT_EQUAL_MEMORY(ACK_EXTENDED, frame, sizeof(ACK_EXTENDED));
+}
+
+void test_execute_extended_sequenced_frame(void) {
+    static const uint8_t ACK_EXTENDED[] = {0x80, 0x00, 0x08, 0x2a, 0x00, 0x00, 0x77, 0x8f};
+    uint8_t frame[64] = {0x80, 0x00, 0x0a, 0x2a, 0x01, 0x01, 0x10, 0x02, 0xf3, 0x7d};
+
+    fake_output.result = PREAT_NO_ERROR;
+
+    PreatExecute(frame);
+    TEST_ASSERT_TRUE(fake_output.called);
+    TEST_ASSERT_EQUAL_MEMORY(ACK_EXTENDED, frame, sizeof(ACK_EXTENDED));
+}
+
+void test_extended_frame_with_invalid_length(void) {
+    static const uint8_t NACK_EXTENDED[] = {0x00, 0x00, 0x09, 0x00, 0x11, 0x10, 0x01, 0x39, 0x47};
+    uint8_t frame[64] = {0x00, 0x02, 0x01, 0x01, 0x01, 0x10, 0x02, 0xe2, 0x06};
+
+    PreatExecute(frame);
+    TEST_ASSERT_FALSE(fake_output.called);
+    TEST_ASSERT_EQUAL_MEMORY(NACK_EXTENDED, frame, sizeof(NACK_EXTENDED));
+}
+
+void test_query_frame_capacity(void) {
+    static const uint8_t ACK_CAPACITY[] = {0x08, 0x00, 0x01, 0x20, 0x02, 0x00, 0x2b, 0x87};
+    uint8_t frame[64] = {0x05, 0x03, 0x10, 0x5b, 0xf9};
+
+    PreatExecute(frame);
+    TEST_ASSERT_EQUAL_MEMORY(ACK_CAPACITY, frame, sizeof(ACK_CAPACITY));
+}
+
+void test_execute_method_with_binary_parameter(void) {
+    static const uint8_t EXPECTED[] = {0xaa, 0xbb, 0xcc};
+    uint8_t frame[64] = {0x0b, 0x7d, 0x42, 0x83, 0xaa, 0xbb, 0xcc, 0x10, 0x07, 0xc6, 0x00};
+
+    PreatExecute(frame);
+    TEST_ASSERT_TRUE(fake_binary.called);
+    TEST_ASSERT_EQUAL(sizeof(EXPECTED), fake_binary.slice.length);
+    TEST_ASSERT_EQUAL_PTR(&frame[4], fake_binary.slice.data);
+    TEST_ASSERT_EQUAL_MEMORY(EXPECTED, fake_binary.value, sizeof(EXPECTED));
+    TEST_ASSERT_EQUAL(0x07, fake_binary.parameter);
+    TEST_ASSERT_EQUAL_MEMORY(ACK_NO_ERROR, frame, sizeof(ACK_NO_ERROR));
+}
+
+void test_execute_method_with_empty_binary_parameter(void) {
+    uint8_t frame[64] = {0x08, 0x7d, 0x42, 0x80, 0x10, 0x07, 0x9c, 0xa5};
+
+    PreatExecute(frame);
+    TEST_ASSERT_FALSE(fake_binary.called);
+    TEST_ASSERT_EQUAL_MEMORY(NACK_PARAMETERS_ERROR, frame, sizeof(NACK_PARAMETERS_ERROR));
+}
+
+void test_execute_method_with_binary_parameter_beyond_frame(void) {
+    uint8_t frame[64] = {0x0b, 0x7d, 0x42, 0x88, 0xaa, 0xbb, 0xcc, 0x10, 0x07, 0x33, 0xef};
+
+    PreatExecute(frame);
+    TEST_ASSERT_FALSE(fake_binary.called);
+    TEST_ASSERT_EQUAL_MEMORY(NACK_PARAMETERS_ERROR, frame, sizeof(NACK_PARAMETERS_ERROR));
+}
+
+void test_execute_method_with_binary_type_in_nibble(void) {
+    uint8_t frame[64] = {0x17, 0x7d, 0x52, 0x19, 0x07, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06,
+                         0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0xf2, 0x2b};
+
+    PreatExecute(frame);
+    TEST_ASSERT_FALSE(fake_binary.called);
+    TEST_ASSERT_EQUAL_MEMORY(NACK_PARAMETERS_ERROR, frame, sizeof(NACK_PARAMETERS_ERROR));
+}
+
+void test_result_bytes_use_their_own_type_byte(void) {
+    static const uint8_t EXPECTED[] = {0x12, 0x01, 0x00, 0x02, 0x82, 0xaa, 0xbb, 0x10, 0x03};
+    static const uint8_t BYTES[] = {0xaa, 0xbb};
+    struct preat_results_s results = {0};
+    struct preat_parameters_s view = {.results = &results};
+
+    TEST_ASSERT_TRUE(PreatResultAppend(&view, TYPE_UINT8, 1));
+    TEST_ASSERT_FALSE(PreatResultAppendBytes(&view, BYTES, sizeof(BYTES)));
+    TEST_ASSERT_TRUE(PreatResultAppend(&view, TYPE_UINT16, 2));
+    TEST_ASSERT_FALSE(PreatResultAppendBytes(&view, BYTES, 0));
+    TEST_ASSERT_TRUE(PreatResultAppendBytes(&view, BYTES, sizeof(BYTES)));
+    TEST_ASSERT_TRUE(PreatResultAppend(&view, TYPE_UINT8, 3));
+
+    TEST_ASSERT_EQUAL(4, results.count);
+    TEST_ASSERT_EQUAL(sizeof(EXPECTED), results.length);
+    TEST_ASSERT_EQUAL_MEMORY(EXPECTED, results.data, sizeof(EXPECTED));
+}
+
 /* === End of documentation ==================================================================== */
 
 /** @} End of module definition for doxygen */
@@ -0,0 +1,914 @@
+/************************************************************************************************
+Copyright (c) 2022-2023, Laboratorio de Microprocesadores
+Facultad de Ciencias Exactas y Tecnología, Universidad Nacional de Tucumán
+https://www.microprocesadores.unt.edu.ar/
+
+Copyright (c) 2022-2023, Esteban Volentini <evolentini@herrera.unt.edu.ar>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Serial server over DMA transfers unit tests
+ **
+ ** \addtogroup preat PREAT
+ ** \brief Protocol for Remote Excecution of Automated Tests
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "unity.h"
+#include "crc.h"
+#include "blob.h"
+#include "serial.h"
+#include "protocol.h"
+#include "assertion.h"
+#include "fake_sci.h"
+#include "fake_events.h"
+#include "fake_lock.h"
+#include <string.h>
+
+/* === Macros definitions ====================================================================== */
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+static preat_server_t server;
+
+static const struct hal_sci_pins_s server_pins = {0};
+
+static uint32_t fake_clock;
+
+static uint8_t blob_content[2 * PREAT_BULK_CHUNK_SIZE + 16];
+
+static uint8_t fake_handler;
+
+static preat_server_t restarted;
+
+static struct memory_port_s {
+    const uint8_t * data;
+    uint16_t size;
+    uint16_t position;
+    uint16_t length;
+    uint16_t capacity;
+    uint8_t sent[PREAT_FRAME_EXTENDED_LENGTH];
+} memory_port;
+
+/* === Private function declarations =========================================================== */
+
+static uint16_t MemoryReceive(void * port, uint8_t * data, uint16_t size);
+
+static uint16_t MemorySend(void * port, const uint8_t * data, uint16_t size);
+
+static bool MemoryConfigure(void * port, uint32_t baud_rate);
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+static const struct preat_transport_s memory_transport = {
+    .receive = MemoryReceive,
+    .send = MemorySend,
+    .configure = NULL,
+};
+
+static const struct preat_transport_s interrupted_transport = {
+    .receive = MemoryReceive,
+    .send = MemorySend,
+    .configure = MemoryConfigure,
+};
+
+// clang-format off
+static const uint8_t SET_OUTPUT[]            = {0x07, 0x01, 0x01, 0x10, 0x01, 0xb5, 0xa3};
+static const uint8_t ACK_NO_ERROR[]          = {0x05, 0x00, 0x00, 0xa1, 0xb5};
+static const uint8_t NACK_PARAMETERS_ERROR[] = {0x07, 0x00, 0x11, 0x10, 0x03, 0xbf, 0x97};
+static const uint8_t LINK_COUNTERS[]         = {0x05, 0x03, 0x20, 0x19, 0xcf};
+static const uint8_t LINK_BAUDRATE[]         = {0x0a, 0x03, 0x31, 0x30, 0x00, 0x0e, 0x10, 0x00,
+                                                0x80, 0x99};
+static const uint8_t LINK_INVALID_BAUDRATE[] = {0x0a, 0x03, 0x31, 0x30, 0x00, 0x00, 0x00, 0x00,
+                                                0xf8, 0x0f};
+static const uint8_t LINK_CONFIRM[]          = {0x05, 0x03, 0x40, 0x9d, 0xa3};
+static const uint8_t CREATE_BLOB[]           = {0x0b, 0x00, 0x22, 0x13, 0x01, 0x00, 0x00, 0x01,
+                                                0x10, 0x9d, 0x47};
+static const uint8_t BLOB_UPLOAD[]           = {0x07, 0x00, 0x81, 0x10, 0x01, 0xbe, 0x15};
+static const uint8_t DESTROY_BLOB[]          = {0x07, 0x00, 0x41, 0x10, 0x01, 0xbb, 0xce};
+static const uint8_t NACK_BUSY_ERROR[]       = {0x07, 0x00, 0x11, 0x10, 0x0b, 0xa0, 0x9e};
+static const uint8_t EVENT_ASSERT[]          = {0x08, 0x05, 0x12, 0x11, 0x00, 0x05, 0xda, 0xde};
+static const uint8_t EVENT_NOTIFY[]          = {0x0b, 0x05, 0x02, 0x31, 0x00, 0x00, 0x10, 0x00,
+                                                0x00, 0x4c, 0x4c};
+// clang-format on
+
+/* === Private function implementation ========================================================= */
+
+static uint16_t MemoryReceive(void * port, uint8_t * data, uint16_t size) {
+    struct memory_port_s * memory = port;
+    uint16_t result = memory->size - memory->position;
+
+    result = (result < size) ? result : size;
+    memcpy(data, memory->data + memory->position, result);
+    memory->position += result;
+    return result;
+}
+
+static uint16_t MemorySend(void * port, const uint8_t * data, uint16_t size) {
+    struct memory_port_s * memory = port;
+
+    /* A capacity other than zero simulates a transport that takes only part of the bytes */
+    if ((memory->capacity != 0) && (memory->length + size > memory->capacity)) {
+        size = memory->capacity - memory->length;
+    }
+    memcpy(memory->sent + memory->length, data, size);
+    memory->length += size;
+    return size;
+}
+
+static bool MemoryConfigure(void * port, uint32_t baud_rate) {
+    /* Simulates the interrupts of the transport raised while the server starts again */
+    ServerReceiveEvent(restarted, false);
+    ServerTransmitEvent(restarted);
+    ServerSignalEvent(restarted);
+    return true;
+}
+
+static void ReceiveFrames(const uint8_t * data, uint16_t size, uint8_t count) {
+    while (count--) {
+        FakeSciDmaReceive(data, size);
+    }
+}
+
+static void OutputFrame(uint8_t * frame, uint8_t value) {
+    crc_t crc;
+
+    memcpy(frame, SET_OUTPUT, sizeof(SET_OUTPUT));
+    frame[4] = value;
+    crc = crc_finalize(crc_update(crc_init(), frame, sizeof(SET_OUTPUT) - 2));
+    frame[5] = (uint8_t)(crc >> 8);
+    frame[6] = (uint8_t)(crc & 0xFF);
+}
+
+static void AssertCommand(const uint8_t * expected, uint16_t size, preat_error_t expected_status) {
+    uint8_t command[PREAT_FRAME_EXTENDED_LENGTH];
+    preat_error_t status = PREAT_GENERIC_ERROR;
+
+    TEST_ASSERT_TRUE(ServerReceiveCommand(server, command, &status));
+    TEST_ASSERT_EQUAL(expected_status, status);
+    TEST_ASSERT_EQUAL_MEMORY(expected, command, size);
+}
+
+static void ExecuteCommand(const uint8_t * request, uint16_t size, uint8_t * response) {
+    preat_error_t status;
+
+    FakeSciDmaReceive(request, size);
+    FakeSciDmaEvent(SCI_DMA_RECEIVE_IDLE);
+    TEST_ASSERT_TRUE(ServerReceiveCommand(server, response, &status));
+    PreatExecuteChecked(response, status, server);
+    TEST_ASSERT_TRUE(ServerTransmitResponse(server, response));
+    FakeSciDmaTransmitDone();
+}
+
+static void ChangeBaudRate(void) {
+    uint8_t response[PREAT_FRAME_EXTENDED_LENGTH];
+
+    ExecuteCommand(LINK_BAUDRATE, sizeof(LINK_BAUDRATE), response);
+    TEST_ASSERT_EQUAL_MEMORY(ACK_NO_ERROR, response, sizeof(ACK_NO_ERROR));
+    fake_clock += PREAT_LINK_CHECK_PERIOD;
+    ServerCheckLink(server);
+    TEST_ASSERT_EQUAL(921600, fake_sci->baud_rate);
+}
+
+static preat_server_t StartMemoryServer(void) {
+    memset(&memory_port, 0, sizeof(memory_port));
+    return ServerStart(&memory_transport, &memory_port);
+}
+
+static void FakeHandler(preat_server_t server, void * object) {
+    fake_handler++;
+}
+
+static preat_server_t StartUpload(void) {
+    uint8_t frame[PREAT_FRAME_EXTENDED_LENGTH];
+    preat_server_t link = StartMemoryServer();
+
+    for (uint16_t index = 0; index < sizeof(blob_content); index++) {
+        blob_content[index] = (uint8_t)(index * 7 + 1);
+    }
+    BlobClean();
+    memcpy(frame, CREATE_BLOB, sizeof(CREATE_BLOB));
+    PreatExecuteChecked(frame, PREAT_NO_ERROR, link);
+    memcpy(frame, BLOB_UPLOAD, sizeof(BLOB_UPLOAD));
+    PreatExecuteChecked(frame, PREAT_NO_ERROR, link);
+    TEST_ASSERT_TRUE(ServerTransmitResponse(link, frame));
+    memory_port.length = 0;
+    return link;
+}
+
+static void SendChunk(preat_server_t link, uint8_t index, const uint8_t * data, bool valid) {
+    static uint8_t chunk[PREAT_BULK_CHUNK_SIZE + 3];
+    uint16_t size = sizeof(blob_content) - index * PREAT_BULK_CHUNK_SIZE;
+    crc_t crc;
+
+    size = (size < PREAT_BULK_CHUNK_SIZE) ? size : PREAT_BULK_CHUNK_SIZE;
+    chunk[0] = index;
+    memcpy(chunk + 1, data + index * PREAT_BULK_CHUNK_SIZE, size);
+    crc = crc_finalize(crc_update(crc_init(), chunk, size + 1));
+    chunk[size + 1] = (uint8_t)(crc >> 8);
+    chunk[size + 2] = (uint8_t)(crc & 0xFF) ^ (valid ? 0x00 : 0x01);
+
+    memory_port.data = chunk;
+    memory_port.size = size + 3;
+    memory_port.position = 0;
+    ServerReceiveEvent(link, false);
+}
+
+static void FakeCleanup(input_state_t state, event_id_t id) {
+}
+
+static preat_error_t FakeOutput(preat_parameters_t parameters, uint8_t count) {
+    return PREAT_NO_ERROR;
+}
+
+static void StartBackgroundAssertion(preat_server_t link) {
+    static const uint8_t ASSERT[] = {0x33, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x32,
+                                     0x11, 0x01, ASSERT_OPERATOR_AND | ASSERT_OPERATOR_BACKGROUND};
+    static const uint8_t OUTPUT[] = {0x10, 0x01};
+    struct preat_results_s results = {.context = link};
+    struct preat_parameters_s start[] = {{
+        .data = ASSERT,
+        .signature = PREAT_PARAMETER(0, TYPE_UINT32) | PREAT_PARAMETER(1, TYPE_UINT32) |
+                     PREAT_PARAMETER(2, TYPE_UINT8) | PREAT_PARAMETER(3, TYPE_UINT8),
+        .offsets = {1, 5, 10, 11},
+        .results = &results,
+    }};
+    struct preat_parameters_s output[] = {{
+        .data = OUTPUT,
+        .signature = PREAT_PARAMETER(0, TYPE_UINT8),
+        .offsets = {1},
+        .results = &results,
+    }};
+
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR, AssertStart(start, 4));
+    AssertRegisterEvent(link, FakeCleanup, NULL);
+    TEST_ASSERT_EQUAL(PREAT_NO_ERROR, AssertExecute(FakeOutput, output, 1));
+}
+
+static void ServeNotifications(preat_server_t link) {
+    uint8_t frame[PREAT_FRAME_MAX_LENGTH];
+
+    /* The same loop that the server task runs after the commands */
+    while (!ServerTransmitHeld(link) && AssertNotification(link, frame)) {
+        TEST_ASSERT_TRUE(ServerTransmitFrame(link, frame));
+    }
+}
+
+static void AssertFrameReceived(preat_server_t link) {
+    uint8_t command[PREAT_FRAME_EXTENDED_LENGTH];
+
+    memory_port.data = SET_OUTPUT;
+    memory_port.size = sizeof(SET_OUTPUT);
+    memory_port.position = 0;
+    ServerReceiveEvent(link, false);
+    TEST_ASSERT_TRUE(ServerReceiveCommand(link, command, NULL));
+    TEST_ASSERT_EQUAL_MEMORY(SET_OUTPUT, command, sizeof(SET_OUTPUT));
+}
+
+/* === Public function implementation ========================================================= */
+
+uint32_t ServerTimestamp(void) {
+    return fake_clock;
+}
+
+void setUp(void) {
+    fake_clock = 0;
+    fake_handler = 0;
+    FakeSciReset();
+    server = ServerStartSerialDma(NULL, &server_pins);
+    FakeEventsReset();
+    FakeLockReset();
+}
+
+void tearDown(void) {
+    TEST_ASSERT_EQUAL(0, fake_locks[PREAT_LOCK_TRANSMIT].depth);
+}
+
+void test_frame_received_when_line_is_idle(void) {
+    uint8_t command[PREAT_FRAME_EXTENDED_LENGTH];
+
+    FakeSciDmaReceive(SET_OUTPUT, sizeof(SET_OUTPUT));
+    TEST_ASSERT_FALSE(ServerReceiveCommand(server, command, NULL));
+
+    FakeSciDmaEvent(SCI_DMA_RECEIVE_IDLE);
+    AssertCommand(SET_OUTPUT, sizeof(SET_OUTPUT), PREAT_NO_ERROR);
+    TEST_ASSERT_FALSE(ServerReceiveCommand(server, command, NULL));
+}
+
+void test_frames_received_in_the_same_event(void) {
+    ReceiveFrames(SET_OUTPUT, sizeof(SET_OUTPUT), 2);
+    FakeSciDmaEvent(SCI_DMA_RECEIVE_IDLE);
+
+    AssertCommand(SET_OUTPUT, sizeof(SET_OUTPUT), PREAT_NO_ERROR);
+    AssertCommand(SET_OUTPUT, sizeof(SET_OUTPUT), PREAT_NO_ERROR);
+}
+
+void test_frame_received_across_the_end_of_buffer(void) {
+    uint8_t count = PREAT_DMA_BUFFER_SIZE / sizeof(SET_OUTPUT);
+
+    TEST_ASSERT_NOT_EQUAL(0, PREAT_DMA_BUFFER_SIZE % sizeof(SET_OUTPUT));
+    while (count--) {
+        FakeSciDmaReceive(SET_OUTPUT, sizeof(SET_OUTPUT));
+        FakeSciDmaEvent(SCI_DMA_RECEIVE_IDLE);
+        AssertCommand(SET_OUTPUT, sizeof(SET_OUTPUT), PREAT_NO_ERROR);
+    }
+
+    FakeSciDmaReceive(SET_OUTPUT, sizeof(SET_OUTPUT));
+    FakeSciDmaEvent(SCI_DMA_RECEIVE_IDLE);
+    AssertCommand(SET_OUTPUT, sizeof(SET_OUTPUT), PREAT_NO_ERROR);
+}
+
+void test_frame_with_crc_error_is_reported(void) {
+    uint8_t frame[sizeof(SET_OUTPUT)];
+
+    memcpy(frame, SET_OUTPUT, sizeof(frame));
+    frame[4] ^= 0x01;
+    FakeSciDmaReceive(frame, sizeof(frame));
+    FakeSciDmaEvent(SCI_DMA_RECEIVE_IDLE);
+
+    AssertCommand(frame, sizeof(frame), PREAT_CRC_ERROR);
+}
+
+void test_partial_frame_dropped_after_idle_gap(void) {
+    FakeSciDmaReceive(SET_OUTPUT, 3);
+    FakeSciDmaEvent(SCI_DMA_RECEIVE_IDLE);
+    fake_clock += PREAT_INTERBYTE_TIMEOUT + 1;
+    FakeSciDmaReceive(SET_OUTPUT, sizeof(SET_OUTPUT));
+    FakeSciDmaEvent(SCI_DMA_RECEIVE_IDLE);
+
+    AssertCommand(SET_OUTPUT, 1, PREAT_FRAMING_ERROR);
+    AssertCommand(SET_OUTPUT, sizeof(SET_OUTPUT), PREAT_NO_ERROR);
+}
+
+void test_partial_frame_dropped_by_the_link_check(void) {
+    static const uint8_t GARBAGE[] = {0xff, 0x00, 0x02};
+    uint8_t command[PREAT_FRAME_EXTENDED_LENGTH];
+    struct preat_server_counters_s counters;
+
+    server = ServerStartSerial(NULL, &server_pins);
+    ServerSetEventHandler(server, FakeHandler, NULL);
+    FakeSciFifoReceive(SET_OUTPUT, 3);
+    fake_clock += PREAT_INTERBYTE_TIMEOUT;
+    ServerCheckLink(server);
+    TEST_ASSERT_FALSE(ServerReceiveCommand(server, command, NULL));
+
+    fake_clock += 1;
+    ServerCheckLink(server);
+    TEST_ASSERT_EQUAL(1, fake_handler);
+    AssertCommand(SET_OUTPUT, 1, PREAT_FRAMING_ERROR);
+
+    FakeSciFifoReceive(GARBAGE, sizeof(GARBAGE));
+    FakeSciFifoReceive(SET_OUTPUT, sizeof(SET_OUTPUT));
+    AssertCommand(SET_OUTPUT, sizeof(SET_OUTPUT), PREAT_NO_ERROR);
+    TEST_ASSERT_FALSE(ServerReceiveCommand(server, command, NULL));
+    ServerGetCounters(server, &counters);
+    TEST_ASSERT_EQUAL(2, counters.framing);
+}
+
+void test_partial_frame_kept_by_the_link_check_while_bytes_arrive(void) {
+    struct preat_server_counters_s counters;
+
+    FakeSciDmaReceive(SET_OUTPUT, 3);
+    FakeSciDmaEvent(SCI_DMA_RECEIVE_HALF);
+    fake_clock += PREAT_INTERBYTE_TIMEOUT;
+    FakeSciDmaReceive(SET_OUTPUT + 3, 2);
+    ServerCheckLink(server);
+    fake_clock += PREAT_INTERBYTE_TIMEOUT;
+    ServerCheckLink(server);
+    FakeSciDmaReceive(SET_OUTPUT + 5, sizeof(SET_OUTPUT) - 5);
+    FakeSciDmaEvent(SCI_DMA_RECEIVE_IDLE);
+
+    AssertCommand(SET_OUTPUT, sizeof(SET_OUTPUT), PREAT_NO_ERROR);
+    ServerGetCounters(server, &counters);
+    TEST_ASSERT_EQUAL(0, counters.framing);
+}
+
+void test_partial_frame_kept_after_half_buffer_event(void) {
+    struct preat_server_counters_s counters;
+
+    FakeSciDmaReceive(SET_OUTPUT, 3);
+    FakeSciDmaEvent(SCI_DMA_RECEIVE_HALF);
+    fake_clock += PREAT_INTERBYTE_TIMEOUT + 1;
+    FakeSciDmaReceive(SET_OUTPUT + 3, sizeof(SET_OUTPUT) - 3);
+    FakeSciDmaEvent(SCI_DMA_RECEIVE_IDLE);
+
+    AssertCommand(SET_OUTPUT, sizeof(SET_OUTPUT), PREAT_NO_ERROR);
+    ServerGetCounters(server, &counters);
+    TEST_ASSERT_EQUAL(0, counters.framing);
+}
+
+void test_frames_discarded_when_queue_is_full(void) {
+    struct preat_server_counters_s counters;
+
+    ReceiveFrames(SET_OUTPUT, sizeof(SET_OUTPUT), PREAT_PIPELINE_DEPTH + 1);
+    FakeSciDmaEvent(SCI_DMA_RECEIVE_IDLE);
+
+    ServerGetCounters(server, &counters);
+    TEST_ASSERT_EQUAL(PREAT_PIPELINE_DEPTH, counters.received);
+    TEST_ASSERT_EQUAL(1, counters.overflows);
+}
+
+void test_pipeline_filled_before_the_consumer_drains(void) {
+    uint8_t frame[sizeof(SET_OUTPUT)];
+    uint8_t command[PREAT_FRAME_EXTENDED_LENGTH];
+
+    for (uint8_t index = 0; index < PREAT_PIPELINE_DEPTH; index++) {
+        OutputFrame(frame, index);
+        FakeSciDmaReceive(frame, sizeof(frame));
+    }
+    FakeSciDmaEvent(SCI_DMA_RECEIVE_IDLE);
+
+    for (uint8_t index = 0; index < PREAT_PIPELINE_DEPTH; index++) {
+        OutputFrame(frame, index);
+        AssertCommand(frame, sizeof(frame), PREAT_NO_ERROR);
+    }
+    TEST_ASSERT_FALSE(ServerReceiveCommand(server, command, NULL));
+}
+
+void test_frame_dropped_on_overflow_without_corrupting_the_queue(void) {
+    uint8_t frame[sizeof(SET_OUTPUT)];
+    struct preat_server_counters_s counters;
+
+    for (uint8_t index = 0; index <= PREAT_PIPELINE_DEPTH; index++) {
+        OutputFrame(frame, index);
+        FakeSciDmaReceive(frame, sizeof(frame));
+        FakeSciDmaEvent(SCI_DMA_RECEIVE_IDLE);
+    }
+    ServerGetCounters(server, &counters);
+    TEST_ASSERT_EQUAL(PREAT_PIPELINE_DEPTH, counters.received);
+    TEST_ASSERT_EQUAL(1, counters.overflows);
+
+    for (uint8_t index = 0; index < PREAT_PIPELINE_DEPTH; index++) {
+        OutputFrame(frame, index);
+        AssertCommand(frame, sizeof(frame), PREAT_NO_ERROR);
+    }
+
+    /* The slots released by the consumer receive the next frames */
+    OutputFrame(frame, 0xA5);
+    FakeSciDmaReceive(frame, sizeof(frame));
+    FakeSciDmaEvent(SCI_DMA_RECEIVE_IDLE);
+    AssertCommand(frame, sizeof(frame), PREAT_NO_ERROR);
+    ServerGetCounters(server, &counters);
+    TEST_ASSERT_EQUAL(PREAT_PIPELINE_DEPTH + 1, counters.received);
+    TEST_ASSERT_EQUAL(1, counters.overflows);
+}
+
+void test_counters_after_crc_and_framing_errors(void) {
+    static const uint8_t GARBAGE[] = {0x00, 0xff};
+    uint8_t frame[sizeof(SET_OUTPUT)];
+    struct preat_server_counters_s counters;
+
+    memcpy(frame, SET_OUTPUT, sizeof(frame));
+    frame[4] ^= 0x01;
+    FakeSciDmaReceive(frame, sizeof(frame));
+    FakeSciDmaEvent(SCI_DMA_RECEIVE_IDLE);
+    FakeSciDmaReceive(SET_OUTPUT, 3);
+    FakeSciDmaEvent(SCI_DMA_RECEIVE_IDLE);
+    fake_clock += PREAT_INTERBYTE_TIMEOUT + 1;
+    ServerCheckLink(server);
+    FakeSciDmaReceive(GARBAGE, sizeof(GARBAGE));
+    FakeSciDmaReceive(SET_OUTPUT, sizeof(SET_OUTPUT));
+    FakeSciDmaEvent(SCI_DMA_RECEIVE_IDLE);
+
+    AssertCommand(frame, sizeof(frame), PREAT_CRC_ERROR);
+    AssertCommand(SET_OUTPUT, 1, PREAT_FRAMING_ERROR);
+    AssertCommand(SET_OUTPUT, sizeof(SET_OUTPUT), PREAT_NO_ERROR);
+    ServerGetCounters(server, &counters);
+    TEST_ASSERT_EQUAL(3, counters.received);
+    TEST_ASSERT_EQUAL(1, counters.crc);
+    TEST_ASSERT_EQUAL(0, counters.overflows);
+    TEST_ASSERT_EQUAL(2, counters.framing);
+}
+
+void test_response_sent_in_a_single_transfer(void) {
+    uint8_t response[sizeof(ACK_NO_ERROR)];
+
+    memcpy(response, ACK_NO_ERROR, sizeof(response));
+    TEST_ASSERT_TRUE(ServerTransmitResponse(server, response));
+    TEST_ASSERT_EQUAL(1, fake_sci->transfers);
+    TEST_ASSERT_EQUAL(sizeof(ACK_NO_ERROR), fake_sci->length);
+    TEST_ASSERT_EQUAL_MEMORY(ACK_NO_ERROR, fake_sci->sent, sizeof(ACK_NO_ERROR));
+}
+
+void test_response_queued_while_previous_transfer_runs(void) {
+    uint8_t response[sizeof(ACK_NO_ERROR)];
+
+    memcpy(response, ACK_NO_ERROR, sizeof(response));
+    TEST_ASSERT_TRUE(ServerTransmitResponse(server, response));
+    TEST_ASSERT_TRUE(ServerTransmitResponse(server, response));
+    TEST_ASSERT_EQUAL(1, fake_sci->transfers);
+    TEST_ASSERT_EQUAL(2, fake_locks[PREAT_LOCK_TRANSMIT].taken);
+
+    FakeSciDmaTransmitDone();
+    TEST_ASSERT_EQUAL(2, fake_sci->transfers);
+    TEST_ASSERT_EQUAL(2 * sizeof(ACK_NO_ERROR), fake_sci->length);
+    TEST_ASSERT_EQUAL_MEMORY(ACK_NO_ERROR, &fake_sci->sent[sizeof(ACK_NO_ERROR)],
+                             sizeof(ACK_NO_ERROR));
+}
+
+void test_queued_frames_sent_back_to_back(void) {
+    uint8_t response[sizeof(ACK_NO_ERROR)];
+
+    memcpy(response, ACK_NO_ERROR, sizeof(response));
+    TEST_ASSERT_TRUE(ServerTransmitResponse(server, response));
+    TEST_ASSERT_TRUE(ServerTransmitResponse(server, response));
+    TEST_ASSERT_TRUE(ServerTransmitFrame(server, NACK_PARAMETERS_ERROR));
+    TEST_ASSERT_TRUE(ServerTransmitResponse(server, response));
+
+    FakeSciDmaTransmitDone();
+    TEST_ASSERT_EQUAL(2, fake_sci->transfers);
+    FakeSciDmaTransmitDone();
+    TEST_ASSERT_EQUAL(2, fake_sci->transfers);
+    TEST_ASSERT_EQUAL(3 * sizeof(ACK_NO_ERROR) + sizeof(NACK_PARAMETERS_ERROR), fake_sci->length);
+    TEST_ASSERT_EQUAL_MEMORY(NACK_PARAMETERS_ERROR, &fake_sci->sent[2 * sizeof(ACK_NO_ERROR)],
+                             sizeof(NACK_PARAMETERS_ERROR));
+}
+
+void test_unsolicited_frame_sent_when_the_link_is_idle(void) {
+    TEST_ASSERT_TRUE(ServerTransmitFrame(server, NACK_PARAMETERS_ERROR));
+    TEST_ASSERT_EQUAL(1, fake_sci->transfers);
+    TEST_ASSERT_EQUAL(sizeof(NACK_PARAMETERS_ERROR), fake_sci->length);
+    TEST_ASSERT_EQUAL_MEMORY(NACK_PARAMETERS_ERROR, fake_sci->sent, sizeof(NACK_PARAMETERS_ERROR));
+}
+
+void test_response_rejected_when_the_queue_is_full(void) {
+    uint8_t response[sizeof(ACK_NO_ERROR)];
+    uint16_t queued = 0;
+
+    memcpy(response, ACK_NO_ERROR, sizeof(response));
+    while (ServerTransmitResponse(server, response)) {
+        queued++;
+    }
+    TEST_ASSERT_EQUAL(PREAT_TRANSMIT_BUFFER_SIZE / sizeof(ACK_NO_ERROR), queued);
+    TEST_ASSERT_FALSE(ServerTransmitFrame(server, NACK_PARAMETERS_ERROR));
+
+    /* The frame queued after the drain is split at the end of the ring */
+    FakeSciDmaTransmitDone();
+    fake_sci->length = 0;
+    TEST_ASSERT_TRUE(ServerTransmitResponse(server, response));
+    FakeSciDmaTransmitDone();
+    FakeSciDmaTransmitDone();
+    TEST_ASSERT_EQUAL(sizeof(ACK_NO_ERROR), fake_sci->length);
+    TEST_ASSERT_EQUAL_MEMORY(ACK_NO_ERROR, fake_sci->sent, sizeof(ACK_NO_ERROR));
+}
+
+void test_server_over_custom_transport(void) {
+    uint8_t response[sizeof(ACK_NO_ERROR)];
+
+    server = StartMemoryServer();
+    TEST_ASSERT_NOT_NULL(server);
+
+    memory_port.data = SET_OUTPUT;
+    memory_port.size = sizeof(SET_OUTPUT);
+    ServerReceiveEvent(server, false);
+    AssertCommand(SET_OUTPUT, sizeof(SET_OUTPUT), PREAT_NO_ERROR);
+
+    memcpy(response, ACK_NO_ERROR, sizeof(response));
+    TEST_ASSERT_TRUE(ServerTransmitResponse(server, response));
+    TEST_ASSERT_EQUAL(sizeof(ACK_NO_ERROR), memory_port.length);
+    TEST_ASSERT_EQUAL_MEMORY(ACK_NO_ERROR, memory_port.sent, sizeof(ACK_NO_ERROR));
+}
+
+void test_servers_receive_frames_independently(void) {
+    uint8_t command[PREAT_FRAME_EXTENDED_LENGTH];
+    preat_server_t link = StartMemoryServer();
+
+    TEST_ASSERT_NOT_NULL(link);
+    TEST_ASSERT_NOT_EQUAL(server, link);
+
+    FakeSciDmaReceive(SET_OUTPUT, sizeof(SET_OUTPUT));
+    FakeSciDmaEvent(SCI_DMA_RECEIVE_IDLE);
+    memory_port.data = LINK_COUNTERS;
+    memory_port.size = sizeof(LINK_COUNTERS);
+    ServerReceiveEvent(link, false);
+
+    AssertCommand(SET_OUTPUT, sizeof(SET_OUTPUT), PREAT_NO_ERROR);
+    TEST_ASSERT_FALSE(ServerReceiveCommand(server, command, NULL));
+    TEST_ASSERT_TRUE(ServerReceiveCommand(link, command, NULL));
+    TEST_ASSERT_EQUAL_MEMORY(LINK_COUNTERS, command, sizeof(LINK_COUNTERS));
+    TEST_ASSERT_FALSE(ServerReceiveCommand(link, command, NULL));
+}
+
+void test_link_request_applied_only_by_its_server(void) {
+    uint8_t frame[PREAT_FRAME_EXTENDED_LENGTH];
+    uint8_t response[PREAT_FRAME_EXTENDED_LENGTH];
+    preat_server_t link = StartMemoryServer();
+
+    memcpy(frame, LINK_BAUDRATE, sizeof(LINK_BAUDRATE));
+    PreatExecuteChecked(frame, PREAT_NO_ERROR, link);
+    TEST_ASSERT_EQUAL_MEMORY(ACK_NO_ERROR, frame, sizeof(ACK_NO_ERROR));
+
+    memcpy(response, ACK_NO_ERROR, sizeof(ACK_NO_ERROR));
+    TEST_ASSERT_TRUE(ServerTransmitResponse(server, response));
+    FakeSciDmaTransmitDone();
+    fake_clock += PREAT_LINK_CHECK_PERIOD;
+    ServerCheckLink(server);
+    TEST_ASSERT_EQUAL(PREAT_BAUD_RATE, fake_sci->baud_rate);
+}
+
+void test_events_ignored_while_the_server_starts_again(void) {
+    preat_server_t link = StartMemoryServer();
+
+    ServerSetEventHandler(link, FakeHandler, NULL);
+    memory_port.data = SET_OUTPUT;
+    memory_port.size = sizeof(SET_OUTPUT);
+    restarted = link;
+    TEST_ASSERT_EQUAL_PTR(link, ServerStart(&interrupted_transport, &memory_port));
+    TEST_ASSERT_EQUAL(0, fake_handler);
+    TEST_ASSERT_EQUAL(0, memory_port.position);
+
+    AssertFrameReceived(link);
+}
+
+void test_blob_released_when_the_server_starts_again(void) {
+    uint8_t frame[PREAT_FRAME_EXTENDED_LENGTH];
+    preat_server_t link = StartUpload();
+
+    SendChunk(link, 0, blob_content, true);
+    TEST_ASSERT_EQUAL_PTR(link, StartMemoryServer());
+    memcpy(frame, DESTROY_BLOB, sizeof(DESTROY_BLOB));
+    PreatExecuteChecked(frame, PREAT_NO_ERROR, server);
+    TEST_ASSERT_EQUAL_MEMORY(ACK_NO_ERROR, frame, sizeof(ACK_NO_ERROR));
+}
+
+void test_server_not_started_when_all_instances_are_in_use(void) {
+    static struct memory_port_s other_port;
+
+    TEST_ASSERT_EQUAL(2, PREAT_SERVER_INSTANCES);
+    TEST_ASSERT_NOT_NULL(StartMemoryServer());
+    TEST_ASSERT_NULL(ServerStart(&memory_transport, &other_port));
+}
+
+void test_link_counters_method(void) {
+    static const uint8_t EXPECTED[] = {0x17, 0x00, 0x04, 0x33, 0x00, 0x00, 0x00, 0x02,
+                                       0x00, 0x00, 0x00, 0x01, 0x33, 0x00, 0x00, 0x00,
+                                       0x00, 0x00, 0x00, 0x00, 0x00, 0xde, 0xb9};
+    uint8_t frame[sizeof(SET_OUTPUT)];
+    uint8_t response[PREAT_FRAME_EXTENDED_LENGTH];
+
+    memcpy(frame, SET_OUTPUT, sizeof(frame));
+    frame[4] ^= 0x01;
+    ExecuteCommand(frame, sizeof(frame), response);
+    ExecuteCommand(LINK_COUNTERS, sizeof(LINK_COUNTERS), response);
+    TEST_ASSERT_EQUAL_MEMORY(EXPECTED, response, sizeof(EXPECTED));
+}
+
+void test_server_starts_at_default_baud_rate(void) {
+    TEST_ASSERT_EQUAL(PREAT_BAUD_RATE, fake_sci->baud_rate);
+}
+
+void test_baud_rate_changed_after_response_is_sent(void) {
+    uint8_t response[PREAT_FRAME_EXTENDED_LENGTH];
+
+    ExecuteCommand(LINK_BAUDRATE, sizeof(LINK_BAUDRATE), response);
+    ServerCheckLink(server);
+    TEST_ASSERT_EQUAL(PREAT_BAUD_RATE, fake_sci->baud_rate);
+
+    fake_clock += PREAT_LINK_CHECK_PERIOD;
+    ServerCheckLink(server);
+    TEST_ASSERT_EQUAL(921600, fake_sci->baud_rate);
+}
+
+void test_invalid_baud_rate_rejected(void) {
+    uint8_t response[PREAT_FRAME_EXTENDED_LENGTH];
+
+    ExecuteCommand(LINK_INVALID_BAUDRATE, sizeof(LINK_INVALID_BAUDRATE), response);
+    TEST_ASSERT_EQUAL_MEMORY(NACK_PARAMETERS_ERROR, response, sizeof(NACK_PARAMETERS_ERROR));
+
+    fake_clock += PREAT_LINK_CHECK_PERIOD;
+    ServerCheckLink(server);
+    TEST_ASSERT_EQUAL(PREAT_BAUD_RATE, fake_sci->baud_rate);
+}
+
+void test_baud_rate_kept_when_confirmed(void) {
+    uint8_t response[PREAT_FRAME_EXTENDED_LENGTH];
+
+    ChangeBaudRate();
+    ExecuteCommand(LINK_CONFIRM, sizeof(LINK_CONFIRM), response);
+    TEST_ASSERT_EQUAL_MEMORY(ACK_NO_ERROR, response, sizeof(ACK_NO_ERROR));
+
+    fake_clock += PREAT_BAUD_CONFIRM_TIMEOUT;
+    ServerCheckLink(server);
+    TEST_ASSERT_EQUAL(921600, fake_sci->baud_rate);
+}
+
+void test_baud_rate_rolled_back_without_confirm(void) {
+    ChangeBaudRate();
+
+    fake_clock += PREAT_BAUD_CONFIRM_TIMEOUT - 1;
+    ServerCheckLink(server);
+    TEST_ASSERT_EQUAL(921600, fake_sci->baud_rate);
+
+    fake_clock += 1;
+    ServerCheckLink(server);
+    TEST_ASSERT_EQUAL(PREAT_BAUD_RATE, fake_sci->baud_rate);
+}
+
+void test_baud_rate_falls_back_when_errors_rise(void) {
+    uint8_t response[PREAT_FRAME_EXTENDED_LENGTH];
+    uint8_t frame[sizeof(SET_OUTPUT)];
+    uint8_t errors;
+
+    ChangeBaudRate();
+    ExecuteCommand(LINK_CONFIRM, sizeof(LINK_CONFIRM), response);
+
+    memcpy(frame, SET_OUTPUT, sizeof(frame));
+    frame[4] ^= 0x01;
+    for (errors = 0; errors < PREAT_LINK_MAX_ERRORS - 1; errors++) {
+        ExecuteCommand(frame, sizeof(frame), response);
+    }
+    ServerCheckLink(server);
+    TEST_ASSERT_EQUAL(921600, fake_sci->baud_rate);
+
+    ExecuteCommand(frame, sizeof(frame), response);
+    ServerCheckLink(server);
+    TEST_ASSERT_EQUAL(PREAT_BAUD_RATE, fake_sci->baud_rate);
+}
+
+void test_bulk_chunks_uploaded_in_order(void) {
+    static const uint8_t EXPECTED[] = {0x00, 0x00, 0x01, 0x00, 0x02, 0x00};
+    preat_server_t link = StartUpload();
+    uint32_t size;
+
+    SendChunk(link, 0, blob_content, true);
+    SendChunk(link, 1, blob_content, true);
+    SendChunk(link, 2, blob_content, true);
+
+    TEST_ASSERT_EQUAL(sizeof(EXPECTED), memory_port.length);
+    TEST_ASSERT_EQUAL_MEMORY(EXPECTED, memory_port.sent, sizeof(EXPECTED));
+    TEST_ASSERT_EQUAL_MEMORY(blob_content, BlobData(1, &size), sizeof(blob_content));
+    AssertFrameReceived(link);
+}
+
+void test_bulk_chunk_sent_again_after_crc_error(void) {
+    static const uint8_t EXPECTED[] = {0x01, 0x01, 0x01, 0x00};
+    static const uint8_t EMPTY[PREAT_BULK_CHUNK_SIZE] = {0};
+    struct preat_server_counters_s counters;
+    preat_server_t link = StartUpload();
+    uint32_t size;
+
+    SendChunk(link, 1, blob_content, false);
+    TEST_ASSERT_EQUAL_MEMORY(EMPTY, BlobData(1, &size) + PREAT_BULK_CHUNK_SIZE, sizeof(EMPTY));
+
+    SendChunk(link, 1, blob_content, true);
+    TEST_ASSERT_EQUAL(sizeof(EXPECTED), memory_port.length);
+    TEST_ASSERT_EQUAL_MEMORY(EXPECTED, memory_port.sent, sizeof(EXPECTED));
+    TEST_ASSERT_EQUAL_MEMORY(blob_content + PREAT_BULK_CHUNK_SIZE,
+                             BlobData(1, &size) + PREAT_BULK_CHUNK_SIZE, PREAT_BULK_CHUNK_SIZE);
+    ServerGetCounters(link, &counters);
+    TEST_ASSERT_EQUAL(1, counters.crc);
+}
+
+void test_bulk_duplicated_chunk_not_written_again(void) {
+    static const uint8_t EXPECTED[] = {0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x02, 0x00};
+    uint8_t other[sizeof(blob_content)];
+    preat_server_t link = StartUpload();
+    uint32_t size;
+
+    memset(other, 0xA5, sizeof(other));
+    SendChunk(link, 0, blob_content, true);
+    SendChunk(link, 0, other, true);
+    SendChunk(link, 1, blob_content, true);
+    SendChunk(link, 2, blob_content, true);
+
+    TEST_ASSERT_EQUAL(sizeof(EXPECTED), memory_port.length);
+    TEST_ASSERT_EQUAL_MEMORY(EXPECTED, memory_port.sent, sizeof(EXPECTED));
+    TEST_ASSERT_EQUAL_MEMORY(blob_content, BlobData(1, &size), sizeof(blob_content));
+    AssertFrameReceived(link);
+}
+
+void test_bulk_transfer_aborted_by_an_invalid_index(void) {
+    static const uint8_t EXPECTED[] = {0x03, 0x02};
+    static const uint8_t INVALID[] = {0x03};
+    uint8_t frame[PREAT_FRAME_EXTENDED_LENGTH];
+    preat_server_t link = StartUpload();
+
+    memory_port.data = INVALID;
+    memory_port.size = sizeof(INVALID);
+    ServerReceiveEvent(link, false);
+
+    TEST_ASSERT_EQUAL(sizeof(EXPECTED), memory_port.length);
+    TEST_ASSERT_EQUAL_MEMORY(EXPECTED, memory_port.sent, sizeof(EXPECTED));
+    AssertFrameReceived(link);
+    memcpy(frame, DESTROY_BLOB, sizeof(DESTROY_BLOB));
+    PreatExecuteChecked(frame, PREAT_NO_ERROR, server);
+    TEST_ASSERT_EQUAL_MEMORY(ACK_NO_ERROR, frame, sizeof(ACK_NO_ERROR));
+}
+
+void test_bulk_transfer_aborted_when_the_host_stops_sending(void) {
+    preat_server_t link = StartUpload();
+
+    SendChunk(link, 0, blob_content, true);
+    fake_clock += PREAT_BULK_TIMEOUT - 1;
+    ServerCheckLink(link);
+    SendChunk(link, 1, blob_content, true);
+    TEST_ASSERT_EQUAL(4, memory_port.length);
+
+    fake_clock += PREAT_BULK_TIMEOUT;
+    ServerCheckLink(link);
+    AssertFrameReceived(link);
+}
+
+void test_blob_not_destroyed_from_other_link_during_upload(void) {
+    uint8_t frame[PREAT_FRAME_EXTENDED_LENGTH];
+    preat_server_t link = StartUpload();
+
+    SendChunk(link, 0, blob_content, true);
+    memcpy(frame, DESTROY_BLOB, sizeof(DESTROY_BLOB));
+    PreatExecuteChecked(frame, PREAT_NO_ERROR, server);
+    TEST_ASSERT_EQUAL_MEMORY(NACK_BUSY_ERROR, frame, sizeof(NACK_BUSY_ERROR));
+
+    SendChunk(link, 1, blob_content, true);
+    SendChunk(link, 2, blob_content, true);
+    memcpy(frame, DESTROY_BLOB, sizeof(DESTROY_BLOB));
+    PreatExecuteChecked(frame, PREAT_NO_ERROR, server);
+    TEST_ASSERT_EQUAL_MEMORY(ACK_NO_ERROR, frame, sizeof(ACK_NO_ERROR));
+}
+
+void test_bulk_ack_taken_in_part_is_not_split_by_a_frame(void) {
+    static const uint8_t EXPECTED[] = {0x00, 0x00, 0x05, 0x00, 0x00, 0xa1, 0xb5};
+    uint8_t frame[PREAT_FRAME_EXTENDED_LENGTH];
+    preat_server_t link = StartUpload();
+
+    memory_port.capacity = 1;
+    SendChunk(link, 0, blob_content, true);
+    TEST_ASSERT_EQUAL(1, memory_port.length);
+
+    memcpy(frame, ACK_NO_ERROR, sizeof(ACK_NO_ERROR));
+    TEST_ASSERT_TRUE(ServerTransmitResponse(link, frame));
+    TEST_ASSERT_EQUAL(1, memory_port.length);
+
+    memory_port.capacity = 0;
+    ServerTransmitEvent(link);
+    TEST_ASSERT_EQUAL(sizeof(EXPECTED), memory_port.length);
+    TEST_ASSERT_EQUAL_MEMORY(EXPECTED, memory_port.sent, sizeof(EXPECTED));
+}
+
+void test_notification_held_until_the_bulk_acks_are_sent(void) {
+    static const uint8_t EXPECTED[] = {0x00, 0x00, 0x01, 0x00, 0x02, 0x00};
+    preat_server_t link = StartUpload();
+
+    SendChunk(link, 0, blob_content, true);
+    TEST_ASSERT_TRUE(ServerTransmitHeld(link));
+    TEST_ASSERT_FALSE(ServerTransmitFrame(link, EVENT_NOTIFY));
+    SendChunk(link, 1, blob_content, true);
+    memory_port.capacity = memory_port.length + 1;
+    SendChunk(link, 2, blob_content, true);
+    TEST_ASSERT_TRUE(ServerTransmitHeld(link));
+    TEST_ASSERT_FALSE(ServerTransmitFrame(link, EVENT_NOTIFY));
+
+    memory_port.capacity = 0;
+    ServerTransmitEvent(link);
+    TEST_ASSERT_FALSE(ServerTransmitHeld(link));
+    TEST_ASSERT_TRUE(ServerTransmitFrame(link, EVENT_NOTIFY));
+    TEST_ASSERT_EQUAL(sizeof(EXPECTED) + sizeof(EVENT_NOTIFY), memory_port.length);
+    TEST_ASSERT_EQUAL_MEMORY(EXPECTED, memory_port.sent, sizeof(EXPECTED));
+    TEST_ASSERT_EQUAL_MEMORY(EVENT_NOTIFY, memory_port.sent + sizeof(EXPECTED),
+                             sizeof(EVENT_NOTIFY));
+}
+
+void test_background_assertion_notified_after_the_bulk_acks(void) {
+    static const uint8_t EXPECTED[] = {0x00, 0x00, 0x01, 0x00, 0x02, 0x00};
+    preat_server_t link = StartUpload();
+
+    StartBackgroundAssertion(link);
+    SendChunk(link, 0, blob_content, true);
+    fake_events->clock += 100 * 1000;
+    ServeNotifications(link);
+    TEST_ASSERT_EQUAL(2, memory_port.length);
+    TEST_ASSERT_EQUAL(0, AssertPendingTime(link));
+
+    SendChunk(link, 1, blob_content, true);
+    SendChunk(link, 2, blob_content, true);
+    ServeNotifications(link);
+    TEST_ASSERT_EQUAL(sizeof(EXPECTED) + sizeof(EVENT_ASSERT), memory_port.length);
+    TEST_ASSERT_EQUAL_MEMORY(EXPECTED, memory_port.sent, sizeof(EXPECTED));
+    TEST_ASSERT_EQUAL_MEMORY(EVENT_ASSERT, memory_port.sent + sizeof(EXPECTED),
+                             sizeof(EVENT_ASSERT));
+    TEST_ASSERT_EQUAL(UINT32_MAX, AssertPendingTime(link));
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
@@ -44,13 +44,32 @@ SPDX-License-Identifier: MIT
 
 struct input_state_s {
     hal_gpio_bit_t input;
-    event_id_t event_id;
+    event_flags_t rissing; /**< Events of the assertions that expect a rissing edge */
+    event_flags_t falling; /**< Events of the assertions that expect a falling edge */
+    uint8_t index;         /**< Number of the input, used to identify its events in the monitor */
+    bool monitored;        /**< Flag to record all the edges in the events monitor */
 };
 
 /* === Private variable declarations =========================================================== */
 
 /* === Private function declarations =========================================================== */
 
+static preat_error_t HasRissing(preat_parameters_t parameters, uint8_t count);
+
+static preat_error_t HasFalling(preat_parameters_t parameters, uint8_t count);
+
+static preat_error_t HasChanged(preat_parameters_t parameters, uint8_t count);
+
+static preat_error_t ActivateOutput(preat_parameters_t parameters, uint8_t count);
+
+static preat_error_t DeactivateOutput(preat_parameters_t parameters, uint8_t count);
+
+static preat_error_t ToogleOutput(preat_parameters_t parameters, uint8_t count);
+
+static preat_error_t MonitorInputs(preat_parameters_t parameters, uint8_t count);
+
+static void GpioEventsHandler(hal_gpio_bit_t gpio, bool rissing, void * object);
+
 /* === Public variable definitions ============================================================= */
 
 static hal_gpio_bit_t inputs[GPIO_INPUTS_COUNT];
@@ -61,32 +80,68 @@ static hal_gpio_bit_t outputs[GPIO_OUTPUTS_COUNT];
 
 /* === Private variable definitions ============================================================ */
 
+PREAT_METHOD(gpio_set, 0x010, true, ActivateOutput, PREAT_SINGLE_UINT8);
+
+PREAT_METHOD(gpio_clear, 0x011, true, DeactivateOutput, PREAT_SINGLE_UINT8);
+
+PREAT_METHOD(gpio_toggle, 0x012, true, ToogleOutput, PREAT_SINGLE_UINT8);
+
+PREAT_METHOD(gpio_has_rissing, 0x013, false, HasRissing, PREAT_SINGLE_UINT8);
+
+PREAT_METHOD(gpio_has_falling, 0x014, false, HasFalling, PREAT_SINGLE_UINT8);
+
+PREAT_METHOD(gpio_has_changed, 0x015, false, HasChanged, PREAT_SINGLE_UINT8);
+
+PREAT_METHOD(gpio_monitor, 0x018, false, MonitorInputs, PREAT_PARAMETER(0, TYPE_UINT32));
+
 /* === Private function implementation ========================================================= */
 
-static void GpioInputCleanup(input_state_t state) {
-    GpioSetEventHandler(state->input, NULL, NULL, false, false);
+static void GpioInputUpdate(input_state_t state) {
+    bool rissing = state->monitored || (state->rissing != 0);
+    bool falling = state->monitored || (state->falling != 0);
+
+    if (rissing || falling) {
+        GpioSetEventHandler(state->input, GpioEventsHandler, state, rissing, falling);
+    } else {
+        GpioSetEventHandler(state->input, NULL, NULL, false, false);
+    }
+}
+
+static void GpioInputCleanup(input_state_t state, event_id_t id) {
+    state->rissing &= ~id;
+    state->falling &= ~id;
+    GpioInputUpdate(state);
 }
 
 static void GpioEventsHandler(hal_gpio_bit_t gpio, bool rissing, void * object) {
     input_state_t state = object;
+    event_flags_t events = rissing ? state->rissing : state->falling;
 
-    AssertSetEvent(state->event_id);
+    /* A monitored input interrupts on both edges, the assertions only take the expected ones */
+    if (state->monitored) {
+        MonitorRecord(state->index, rissing);
+    }
+    if (events != 0) {
+        AssertSignalEvents(events);
+    }
 }
 
-static preat_error_t ExecuteInput(uint8_t input, bool rissing, bool falling) {
+static preat_error_t ExecuteInput(void * context, uint8_t input, bool rissing, bool falling) {
     preat_error_t result = PREAT_NO_ERROR;
 
-    if (input >= GPIO_OUTPUTS_COUNT) {
+    if (input >= GPIO_INPUTS_COUNT) {
         result = PREAT_GENERIC_ERROR;
     } else {
         input_state_t state = &input_states[input];
-        state->input = inputs[input];
-        state->event_id = AssertRegisterEvent(GpioInputCleanup, state);
+        event_id_t event_id = AssertRegisterEvent(context, GpioInputCleanup, state);
 
-        if (state->event_id == ASSERT_EVENT_INVALID_ID) {
+        if (event_id == ASSERT_EVENT_INVALID_ID) {
             result = PREAT_GENERIC_ERROR;
         } else {
-            GpioSetEventHandler(state->input, GpioEventsHandler, state, rissing, falling);
+            /* The same input can be used by several assertions, each one with its own event */
+            state->rissing |= rissing ? event_id : 0;
+            state->falling |= falling ? event_id : 0;
+            GpioInputUpdate(state);
         }
     }
     return result;
@@ -103,53 +158,70 @@ static preat_error_t ExecuteOutput(uint8_t output, void (*action)(hal_gpio_bit_t
     return result;
 }
 
-static preat_error_t HasRissing(const preat_parameter_t parameters, uint8_t count) {
-    return ExecuteInput((uint8_t)parameters->value, true, false);
+static preat_error_t HasRissing(preat_parameters_t parameters, uint8_t count) {
+    return ExecuteInput(PreatContext(parameters), (uint8_t)PreatParameterValue(parameters, 0),
+                        true, false);
+}
+
+static preat_error_t HasFalling(preat_parameters_t parameters, uint8_t count) {
+    return ExecuteInput(PreatContext(parameters), (uint8_t)PreatParameterValue(parameters, 0),
+                        false, true);
 }
 
-static preat_error_t HasFalling(const preat_parameter_t parameters, uint8_t count) {
-    return ExecuteInput((uint8_t)parameters->value, false, true);
+static preat_error_t HasChanged(preat_parameters_t parameters, uint8_t count) {
+    return ExecuteInput(PreatContext(parameters), (uint8_t)PreatParameterValue(parameters, 0),
+                        true, true);
 }
 
-static preat_error_t HasChanged(const preat_parameter_t parameters, uint8_t count) {
-    return ExecuteInput((uint8_t)parameters->value, true, true);
+static preat_error_t ActivateOutput(preat_parameters_t parameters, uint8_t count) {
+    return ExecuteOutput((uint8_t)PreatParameterValue(parameters, 0), GpioBitSet);
 }
 
-static preat_error_t ActivateOutput(const preat_parameter_t parameters, uint8_t count) {
-    return ExecuteOutput((uint8_t)parameters->value, GpioBitSet);
+static preat_error_t DeactivateOutput(preat_parameters_t parameters, uint8_t count) {
+    return ExecuteOutput((uint8_t)PreatParameterValue(parameters, 0), GpioBitClear);
 }
 
-static preat_error_t DeactivateOutput(const preat_parameter_t parameters, uint8_t count) {
-    return ExecuteOutput((uint8_t)parameters->value, GpioBitClear);
+static preat_error_t ToogleOutput(preat_parameters_t parameters, uint8_t count) {
+    return ExecuteOutput((uint8_t)PreatParameterValue(parameters, 0), GpioBitToogle);
 }
 
-static preat_error_t ToogleOutput(const preat_parameter_t parameters, uint8_t count) {
-    return ExecuteOutput((uint8_t)parameters->value, GpioBitToogle);
+static preat_error_t MonitorInputs(preat_parameters_t parameters, uint8_t count) {
+    preat_error_t result = PREAT_NO_ERROR;
+    uint32_t selected = PreatParameterValue(parameters, 0);
+    void * context = PreatContext(parameters);
+    uint8_t index;
+
+    if ((selected >> GPIO_INPUTS_COUNT) != 0) {
+        result = PREAT_PARAMETERS_ERROR;
+    } else if (!((selected != 0) ? MonitorStart(context) : MonitorStop(context))) {
+        result = PREAT_REDEFINED_ERROR;
+    } else {
+        for (index = 0; index < GPIO_INPUTS_COUNT; index++) {
+            input_states[index].monitored = ((selected & (1u << index)) != 0);
+            GpioInputUpdate(&input_states[index]);
+        }
+    }
+    return result;
 }
 
 /* === Public function implementation ========================================================== */
 
-bool RegisterGpioMethods(void) {
+bool GpioMethodsSetup(void) {
     uint8_t index;
     bool result = true;
 
-    GpioInputsListInit(inputs, sizeof(inputs) / sizeof(hal_chip_pin_t));
+    result = result && GpioInputsListInit(inputs, sizeof(inputs) / sizeof(hal_chip_pin_t));
     for (index = 0; index < GPIO_INPUTS_COUNT; index++) {
         GpioSetDirection(inputs[index], false);
+        input_states[index].input = inputs[index];
+        input_states[index].index = index;
     }
 
-    GpioOutputsListInit(outputs, sizeof(outputs) / sizeof(hal_chip_pin_t));
+    result = result && GpioOutputsListInit(outputs, sizeof(outputs) / sizeof(hal_chip_pin_t));
     for (index = 0; index < GPIO_OUTPUTS_COUNT; index++) {
         GpioSetDirection(outputs[index], true);
     }
 
-    result = result && PreatRegister(0x010, true, ActivateOutput, SINGLE_UINT8_PARAM);
-    result = result && PreatRegister(0x011, true, DeactivateOutput, SINGLE_UINT8_PARAM);
-    result = result && PreatRegister(0x012, true, ToogleOutput, SINGLE_UINT8_PARAM);
-    result = result && PreatRegister(0x013, false, HasRissing, SINGLE_UINT8_PARAM);
-    result = result && PreatRegister(0x014, false, HasFalling, SINGLE_UINT8_PARAM);
-    result = result && PreatRegister(0x015, false, HasChanged, SINGLE_UINT8_PARAM);
-
     return result;
 }
 
@@ -35,6 +35,7 @@ SPDX-License-Identifier: MIT
 #include "FreeRTOS.h"
 #include "task.h"
 #include "event_groups.h"
+#include "semphr.h"
 
 #include "board.h"
 #include "gpio.h"
@@ -45,12 +46,19 @@ SPDX-License-Identifier: MIT
 
 /* === Macros definitions ====================================================================== */
 
+/* Los eventos de todas las pruebas deben entrar en los 24 bits de un grupo de eventos */
+#if (PREAT_ASSERTIONS * ASSERT_MAX_CONDITIONS) > 24
+#error "The events of the assertions do not fit in an event group"
+#endif
+
 /* === Private data type declarations ========================================================== */
 
 /* === Private variable declarations =========================================================== */
 
 EventGroupHandle_t inputs_events;
 
+SemaphoreHandle_t preat_locks[PREAT_LOCK_COUNT];
+
 /* === Private function declarations =========================================================== */
 
 /* === Public variable definitions ============================================================= */
@@ -59,15 +67,67 @@ EventGroupHandle_t inputs_events;
 
 /* === Private function implementation ========================================================= */
 
-event_flags_t AssertWaitEvents(event_flags_t events, uint32_t timeout, bool wait_for_all) {
-    EventBits_t result;
+event_flags_t AssertWaitEvents(event_flags_t events, uint32_t timeout) {
+    EventBits_t result = 0;
+
+    if (events == 0) {
+        vTaskDelay(pdMS_TO_TICKS(timeout));
+    } else {
+        result =
+            xEventGroupWaitBits(inputs_events, events, pdTRUE, pdFALSE, pdMS_TO_TICKS(timeout));
+    }
+    return result & events;
+}
 
-    xEventGroupClearBits(inputs_events, events);
-    result = xEventGroupWaitBits(inputs_events, events, pdTRUE, wait_for_all ? pdTRUE : pdFALSE,
-                                 pdMS_TO_TICKS(timeout));
+void ProgramDelay(uint32_t delay) {
+    uint32_t start = PreatTimestamp();
+    TickType_t ticks = pdMS_TO_TICKS(delay);
+
+    if (delay > UINT32_MAX / 1000) {
+        /* Las esperas más largas que una vuelta del contador de microsegundos usan solo el tick */
+        vTaskDelay(ticks);
+    } else {
+        /* Cede el procesador por los ticks completos y mide la fracción final en microsegundos */
+        if (ticks > 1) {
+            vTaskDelay(ticks - 1);
+        }
+        while ((uint32_t)(PreatTimestamp() - start) < delay * 1000) {
+        }
+    }
+}
+
+uint32_t ServerTimestamp(void) {
+    return xTaskGetTickCountFromISR() * portTICK_PERIOD_MS;
+}
+
+uint32_t PreatTimestamp(void) {
+    static uint32_t cycles, microseconds;
+    uint32_t elapsed, result, frequency = SystemCoreClock / 1000000;
+    UBaseType_t state;
+
+    /* Extiende el contador de ciclos, que desborda en segundos, a un contador de microsegundos */
+    state = taskENTER_CRITICAL_FROM_ISR();
+    elapsed = (DWT->CYCCNT - cycles) / frequency;
+    cycles += elapsed * frequency;
+    microseconds += elapsed;
+    result = microseconds;
+    taskEXIT_CRITICAL_FROM_ISR(state);
     return result;
 }
 
+void vApplicationTickHook(void) {
+    /* Lectura periódica para que el contador de ciclos no desborde entre dos lecturas */
+    PreatTimestamp();
+}
+
+void PreatLock(preat_lock_t lock) {
+    xSemaphoreTakeRecursive(preat_locks[lock], portMAX_DELAY);
+}
+
+void PreatUnlock(preat_lock_t lock) {
+    xSemaphoreGiveRecursive(preat_locks[lock]);
+}
+
 void AssertSetEvent(event_id_t id) {
     BaseType_t result, scheduling;
 
@@ -78,29 +138,68 @@ void AssertSetEvent(event_id_t id) {
     }
 }
 
+void AssertWakeContext(void * context) {
+    ServerSignalEvent(context);
+}
+
+void MonitorSetEvent(void * context) {
+    ServerSignalEvent(context);
+}
+
 static void ServerEvent(preat_server_t server, void * object) {
     TaskHandle_t task = object;
-    BaseType_t result, scheduling;
+    BaseType_t scheduling;
 
     scheduling = pdFALSE;
-    result = xTaskResumeFromISR(task);
-    if (result != pdFAIL) {
-        portYIELD_FROM_ISR(scheduling);
-    }
+    vTaskNotifyGiveFromISR(task, &scheduling);
+    portYIELD_FROM_ISR(scheduling);
 }
 
 void ServerTask(void * object) {
-    static uint8_t frame[64] = {0};
+    uint8_t frame[PREAT_FRAME_EXTENDED_LENGTH] = {0};
     preat_server_t server = object;
-
-    RegisterGpioMethods();
+    preat_error_t status;
+    uint32_t wait;
 
     while (true) {
-        vTaskSuspend(NULL);
-        if (ServerReceiveCommand(server, frame)) {
-            PreatExecute(frame);
-            ServerTransmitResponse(server, frame);
+        /* La espera termina antes si vence la ventana de una prueba en segundo plano, salvo durante
+           una transferencia masiva que retiene su notificación */
+        wait = ServerTransmitHeld(server) ? PREAT_LINK_CHECK_PERIOD : AssertPendingTime(server);
+        wait = (wait < PREAT_LINK_CHECK_PERIOD) ? wait : PREAT_LINK_CHECK_PERIOD;
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(wait));
+        while (ServerReceiveCommand(server, frame, &status)) {
+            PreatExecuteChecked(frame, status, server);
+            while (!ServerTransmitResponse(server, frame)) {
+                vTaskDelay(1);
+            }
         }
+        /* Las notificaciones esperan a que termine una transferencia masiva */
+        while (!ServerTransmitHeld(server) && MonitorNotification(server, frame)) {
+            while (!ServerTransmitFrame(server, frame)) {
+                vTaskDelay(1);
+            }
+        }
+        while (!ServerTransmitHeld(server) && AssertNotification(server, frame)) {
+            while (!ServerTransmitFrame(server, frame)) {
+                vTaskDelay(1);
+            }
+        }
+        ServerCheckLink(server);
+    }
+}
+
+static void ServerCreate(hal_sci_t sci, hal_sci_pins_t pins, const char * name) {
+    preat_server_t server;
+    TaskHandle_t task;
+
+#if defined(PREAT_SERIAL_DMA)
+    server = ServerStartSerialDma(sci, pins);
+#else
+    server = ServerStartSerial(sci, pins);
+#endif
+    if (server) {
+        xTaskCreate(ServerTask, name, 2048, (void *)server, tskIDLE_PRIORITY + 1, &task);
+        ServerSetEventHandler(server, ServerEvent, task);
     }
 }
 
@@ -108,18 +207,29 @@ void ServerTask(void * object) {
 
 int main(void) {
     struct hal_sci_pins_s server_pins = {0};
-    preat_server_t server;
-    TaskHandle_t task;
 
     BoardSetup();
+    GpioMethodsSetup();
 
+    /* Contador de ciclos utilizado para las marcas de tiempo de los eventos */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    inputs_events = xEventGroupCreate();
+    for (int index = 0; index < PREAT_LOCK_COUNT; index++) {
+        preat_locks[index] = xSemaphoreCreateRecursiveMutex();
+    }
+
+    /* Enlace principal por el puerto serie de depuración USB */
     server_pins.txd_pin = HAL_PIN_P7_1;
     server_pins.rxd_pin = HAL_PIN_P7_2;
-    server = ServerStartSerial(HAL_SCI_USART2, &server_pins);
+    ServerCreate(HAL_SCI_USART2, &server_pins, "PreatServer");
 
-    inputs_events = xEventGroupCreate();
-    xTaskCreate(ServerTask, "PreatServer", 2048, (void *)server, tskIDLE_PRIORITY + 1, &task);
-    ServerSetEventHandler(server, ServerEvent, task);
+    /* Segundo enlace por el conector RS232 de la placa */
+    server_pins.txd_pin = HAL_PIN_P2_3;
+    server_pins.rxd_pin = HAL_PIN_P2_4;
+    ServerCreate(HAL_SCI_USART3, &server_pins, "PreatServer2");
 
     /* Arranque del sistema operativo */
     vTaskStartScheduler();
@@ -0,0 +1,101 @@
+/************************************************************************************************
+Copyright (c) 2022-2023, Laboratorio de Microprocesadores
+Facultad de Ciencias Exactas y Tecnología, Universidad Nacional de Tucumán
+https://www.microprocesadores.unt.edu.ar/
+
+Copyright (c) 2022-2023, Esteban Volentini <evolentini@herrera.unt.edu.ar>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** @file
+ ** @brief Fake events and clock used by the assertions implementation for unit tests
+ **
+ ** Provides the functions that the assertions expect from the user, so the tests control the
+ ** time and the events that arrive while an assertion is evaluated.
+ **
+ ** @addtogroup preat PREAT
+ ** @brief Protocol for Remote Excecution of Automated Tests
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "fake_events.h"
+#include "unity.h"
+#include <string.h>
+
+/* === Macros definitions ====================================================================== */
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+struct fake_events_s fake_events[1];
+
+/* === Private variable definitions ============================================================ */
+
+/* === Private function implementation ========================================================= */
+
+/* === Public function implementation ========================================================== */
+
+event_flags_t AssertWaitEvents(event_flags_t events, uint32_t timeout) {
+    struct fake_events_call_s * call;
+    event_flags_t result = 0;
+
+    if (fake_events->called < FAKE_EVENTS_CALLS - 1) {
+        call = &fake_events->calls[fake_events->called];
+        call->events = events;
+        call->timeout = timeout;
+        result = call->result;
+        if (result) {
+            fake_events->clock += call->elapsed;
+            AssertSignalEvents(result);
+        } else {
+            fake_events->clock += 1000 * timeout;
+        }
+        fake_events->called++;
+    } else {
+        TEST_FAIL_MESSAGE("No more space to save calls");
+    }
+    return result;
+}
+
+void AssertSetEvent(event_id_t id) {
+    (void)id;
+}
+
+void AssertWakeContext(void * context) {
+    fake_events->woken++;
+    fake_events->context = context;
+}
+
+uint32_t PreatTimestamp(void) {
+    return fake_events->clock;
+}
+
+void FakeEventsReset(void) {
+    memset(fake_events, 0, sizeof(fake_events));
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
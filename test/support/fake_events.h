@@ -0,0 +1,94 @@
+/************************************************************************************************
+Copyright (c) 2022-2023, Laboratorio de Microprocesadores
+Facultad de Ciencias Exactas y Tecnología, Universidad Nacional de Tucumán
+https://www.microprocesadores.unt.edu.ar/
+
+Copyright (c) 2022-2023, Esteban Volentini <evolentini@herrera.unt.edu.ar>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+#ifndef FAKE_EVENTS_H
+#define FAKE_EVENTS_H
+
+/** @file
+ ** @brief Fake events and clock used by the assertions declarations for unit tests
+ **
+ ** @addtogroup preat PREAT
+ ** @brief Protocol for Remote Excecution of Automated Tests
+ ** @{ */
+
+/* === Headers files inclusions ================================================================ */
+
+#include "assertion.h"
+#include <stdint.h>
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+/**
+ * @brief Maximum number of calls to AssertWaitEvents recorded in a test
+ */
+#define FAKE_EVENTS_CALLS 8
+
+/* === Public data type declarations =========================================================== */
+
+/**
+ * @brief State of the fake events and clock, set and inspected by the tests
+ *
+ * Each call to AssertWaitEvents returns the result prepared by the test and moves the clock
+ * forward, by the elapsed time when there is a result or by the full timeout when there is none.
+ */
+typedef struct fake_events_s {
+    uint32_t clock; /**< Time returned by PreatTimestamp, in microseconds */
+    uint8_t called; /**< Number of calls to AssertWaitEvents */
+    struct fake_events_call_s {
+        event_flags_t events; /**< Events waited in the call */
+        uint32_t timeout;     /**< Timeout of the call, in milliseconds */
+        event_flags_t result; /**< Events returned by the call, set by the test */
+        uint32_t elapsed;     /**< Microseconds from the call to the events in result */
+    } calls[FAKE_EVENTS_CALLS];
+    uint8_t woken;  /**< Number of calls to AssertWakeContext */
+    void * context; /**< Context received by the last call to AssertWakeContext */
+} * fake_events_t;
+
+/* === Public variable declarations ============================================================ */
+
+extern struct fake_events_s fake_events[1];
+
+/* === Public function declarations ============================================================ */
+
+/**
+ * @brief Function to clear the recorded calls and the prepared results, and reset the clock
+ */
+void FakeEventsReset(void);
+
+/* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} End of module definition for doxygen */
+
+#endif /* FAKE_EVENTS_H */
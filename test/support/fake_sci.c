@@ -0,0 +1,144 @@
+/************************************************************************************************
+Copyright (c) 2022-2023, Laboratorio de Microprocesadores
+Facultad de Ciencias Exactas y Tecnología, Universidad Nacional de Tucumán
+https://www.microprocesadores.unt.edu.ar/
+
+Copyright (c) 2022-2023, Esteban Volentini <evolentini@herrera.unt.edu.ar>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** @file
+ ** @brief Fake serial port with DMA transfers implementation for unit tests
+ **
+ ** @addtogroup preat PREAT
+ ** @brief Protocol for Remote Excecution of Automated Tests
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "fake_sci.h"
+#include <string.h>
+
+/* === Macros definitions ====================================================================== */
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+struct fake_sci_s fake_sci[1];
+
+/* === Private variable definitions ============================================================ */
+
+/* === Private function implementation ========================================================= */
+
+static void RecordSent(const void * data, uint16_t size) {
+    if (fake_sci->length + size <= sizeof(fake_sci->sent)) {
+        memcpy(&fake_sci->sent[fake_sci->length], data, size);
+        fake_sci->length += size;
+    }
+}
+
+/* === Public function implementation ========================================================== */
+
+bool SciSetConfig(hal_sci_t sci, hal_sci_line_t line, hal_sci_pins_t pins) {
+    fake_sci->baud_rate = line->baud_rate;
+    return true;
+}
+
+uint16_t SciSendData(hal_sci_t sci, void const * const data, uint16_t size) {
+    RecordSent(data, size);
+    return size;
+}
+
+uint16_t SciReceiveData(hal_sci_t sci, void * data, uint16_t size) {
+    size = (size < fake_sci->pending) ? size : fake_sci->pending;
+    memcpy(data, fake_sci->fifo, size);
+    fake_sci->fifo += size;
+    fake_sci->pending -= size;
+    return size;
+}
+
+void SciSetEventHandler(hal_sci_t sci, hal_sci_event_t handler, void * object) {
+    fake_sci->event = handler;
+    fake_sci->object = object;
+}
+
+bool SciDmaStart(hal_sci_t sci, uint8_t * buffer, uint16_t size, sci_dma_handler_t handler,
+                 void * object) {
+    fake_sci->buffer = buffer;
+    fake_sci->size = size;
+    fake_sci->position = 0;
+    fake_sci->handler = handler;
+    fake_sci->object = object;
+    return true;
+}
+
+uint16_t SciDmaReceivePosition(hal_sci_t sci) {
+    return fake_sci->position;
+}
+
+bool SciDmaSend(hal_sci_t sci, const void * data, uint16_t size) {
+    if (fake_sci->sending) {
+        return false;
+    }
+    fake_sci->sending = true;
+    fake_sci->transfers++;
+    RecordSent(data, size);
+    return true;
+}
+
+void FakeSciReset(void) {
+    memset(fake_sci, 0, sizeof(fake_sci));
+}
+
+void FakeSciDmaReceive(const uint8_t * data, uint16_t size) {
+    for (uint16_t index = 0; index < size; index++) {
+        fake_sci->buffer[fake_sci->position] = data[index];
+        fake_sci->position = (fake_sci->position + 1) % fake_sci->size;
+    }
+}
+
+void FakeSciFifoReceive(const uint8_t * data, uint16_t size) {
+    struct sci_status_s status = {.data_ready = true};
+
+    fake_sci->fifo = data;
+    fake_sci->pending = size;
+    if (fake_sci->event) {
+        fake_sci->event(NULL, &status, fake_sci->object);
+    }
+}
+
+void FakeSciDmaTransmitDone(void) {
+    fake_sci->sending = false;
+    FakeSciDmaEvent(SCI_DMA_TRANSMIT_DONE);
+}
+
+void FakeSciDmaEvent(sci_dma_event_t event) {
+    if (fake_sci->handler) {
+        fake_sci->handler(NULL, event, fake_sci->object);
+    }
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
@@ -0,0 +1,124 @@
+/************************************************************************************************
+Copyright (c) 2022-2023, Laboratorio de Microprocesadores
+Facultad de Ciencias Exactas y Tecnología, Universidad Nacional de Tucumán
+https://www.microprocesadores.unt.edu.ar/
+
+Copyright (c) 2022-2023, Esteban Volentini <evolentini@herrera.unt.edu.ar>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+#ifndef FAKE_SCI_H
+#define FAKE_SCI_H
+
+/** @file
+ ** @brief Fake serial port with DMA transfers declarations for unit tests
+ **
+ ** @addtogroup preat PREAT
+ ** @brief Protocol for Remote Excecution of Automated Tests
+ ** @{ */
+
+/* === Headers files inclusions ================================================================ */
+
+#include "hal.h"
+#include "sci_dma.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+/**
+ * @brief Maximum number of bytes recorded from the transmit transfers
+ */
+#define FAKE_SCI_SENT_SIZE 1024
+
+/* === Public data type declarations =========================================================== */
+
+/**
+ * @brief State of the fake serial port, inspected by the tests
+ */
+typedef struct fake_sci_s {
+    uint32_t baud_rate;             /**< Baud rate of the last configuration of the port */
+    hal_sci_event_t event;          /**< Event handler installed with SciSetEventHandler */
+    const uint8_t * fifo;           /**< Bytes waiting in the receive FIFO */
+    uint16_t pending;               /**< Number of bytes waiting in the receive FIFO */
+    sci_dma_handler_t handler;      /**< Event handler installed with SciDmaStart */
+    void * object;                  /**< User data of the installed event handler */
+    uint8_t * buffer;               /**< Circular buffer of the receive DMA transfer */
+    uint16_t size;                  /**< Size of the circular buffer */
+    uint16_t position;              /**< Offset of the next byte written by the receive DMA */
+    bool sending;                   /**< Flag set while a transmit DMA transfer is in progress */
+    uint16_t transfers;             /**< Number of transmit DMA transfers started */
+    uint16_t length;                /**< Number of bytes recorded from the transmit transfers */
+    uint8_t sent[FAKE_SCI_SENT_SIZE]; /**< Bytes sent by the transmit transfers */
+} * fake_sci_t;
+
+/* === Public variable declarations ============================================================ */
+
+extern struct fake_sci_s fake_sci[1];
+
+/* === Public function declarations ============================================================ */
+
+/**
+ * @brief Function to clear the state of the fake serial port
+ */
+void FakeSciReset(void);
+
+/**
+ * @brief Function to simulate bytes written by the receive DMA in the circular buffer
+ *
+ * @param   data    Pointer to the bytes received
+ * @param   size    Number of bytes received
+ */
+void FakeSciDmaReceive(const uint8_t * data, uint16_t size);
+
+/**
+ * @brief Function to simulate bytes received in the FIFO and the data ready event they raise
+ *
+ * @param   data    Pointer to the bytes received, they must remain valid until they are read
+ * @param   size    Number of bytes received
+ */
+void FakeSciFifoReceive(const uint8_t * data, uint16_t size);
+
+/**
+ * @brief Function to simulate the end of the transmit DMA transfer in progress
+ */
+void FakeSciDmaTransmitDone(void);
+
+/**
+ * @brief Function to simulate an event of the DMA transfers
+ *
+ * @param   event   Event raised by the DMA transfers
+ */
+void FakeSciDmaEvent(sci_dma_event_t event);
+
+/* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} End of module definition for doxygen */
+
+#endif /* FAKE_SCI_H */
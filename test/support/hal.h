@@ -0,0 +1,100 @@
+/************************************************************************************************
+Copyright (c) 2022-2023, Laboratorio de Microprocesadores
+Facultad de Ciencias Exactas y Tecnología, Universidad Nacional de Tucumán
+https://www.microprocesadores.unt.edu.ar/
+
+Copyright (c) 2022-2023, Esteban Volentini <evolentini@herrera.unt.edu.ar>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+#ifndef HAL_H
+#define HAL_H
+
+/** @file
+ ** @brief Fake hardware abstraction layer declarations for unit tests
+ **
+ ** Declares the subset of the serial port interface of the hardware abstraction layer used by the
+ ** preat module, implemented in fake_sci.c to run the serial server on the host.
+ **
+ ** @addtogroup preat PREAT
+ ** @brief Protocol for Remote Excecution of Automated Tests
+ ** @{ */
+
+/* === Headers files inclusions ================================================================ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+/* === Public data type declarations =========================================================== */
+
+typedef struct hal_sci_s * hal_sci_t;
+
+typedef enum hal_sci_parity_e {
+    HAL_SCI_NO_PARITY,
+    HAL_SCI_EVEN_PARITY,
+    HAL_SCI_ODD_PARITY,
+} hal_sci_parity_t;
+
+typedef struct hal_sci_line_s {
+    uint32_t baud_rate;
+    uint8_t data_bits;
+    hal_sci_parity_t parity;
+} const * hal_sci_line_t;
+
+typedef struct hal_sci_pins_s {
+    uint8_t txd_pin;
+    uint8_t rxd_pin;
+} const * hal_sci_pins_t;
+
+typedef struct sci_status_s {
+    bool data_ready;
+    bool fifo_empty;
+} const * sci_status_t;
+
+typedef void (*hal_sci_event_t)(hal_sci_t sci, sci_status_t status, void * object);
+
+/* === Public variable declarations ============================================================ */
+
+/* === Public function declarations ============================================================ */
+
+bool SciSetConfig(hal_sci_t sci, hal_sci_line_t line, hal_sci_pins_t pins);
+
+uint16_t SciSendData(hal_sci_t sci, void const * const data, uint16_t size);
+
+uint16_t SciReceiveData(hal_sci_t sci, void * data, uint16_t size);
+
+void SciSetEventHandler(hal_sci_t sci, hal_sci_event_t handler, void * object);
+
+/* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} End of module definition for doxygen */
+
+#endif /* HAL_H */